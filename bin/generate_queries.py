@@ -9,6 +9,7 @@ Uses shared validation module from query_tools.
 import argparse
 import json
 import logging
+import re
 import sys
 from pathlib import Path
 from typing import Dict, List, Any, Optional, Tuple, Set
@@ -35,6 +36,90 @@ class QueryDefinitionError(Exception):
     pass
 
 
+# Backends a query may declare SQL for, in the order their implementations are generated
+SQL_BACKENDS = ["postgresql", "mysql", "mariadb"]
+
+# Named placeholder in declarative SQL, PostgreSQL casts (::type) are left alone
+SQL_PLACEHOLDER = re.compile(r"(?<![:\w]):([a-z][A-Za-z0-9_]*)")
+
+# Connector/C++ setter for each parameter type declarative SQL can bind
+SQL_SETTERS = {
+    "std::string": "setString",
+    "int": "setInt",
+    "std::int32_t": "setInt",
+    "int32_t": "setInt",
+    "unsigned int": "setUInt",
+    "std::uint32_t": "setUInt",
+    "uint32_t": "setUInt",
+    "long long": "setInt64",
+    "std::int64_t": "setInt64",
+    "int64_t": "setInt64",
+    "std::uint64_t": "setUInt64",
+    "uint64_t": "setUInt64",
+    "bool": "setBoolean",
+    "double": "setDouble",
+    "float": "setDouble",
+}
+
+# Connector/C++ getter for each type a batch variant reads back
+SQL_GETTERS = {
+    "std::string": "getString",
+    "int": "getInt",
+    "std::int32_t": "getInt",
+    "int32_t": "getInt",
+    "unsigned int": "getUInt",
+    "std::uint32_t": "getUInt",
+    "uint32_t": "getUInt",
+    "long long": "getInt64",
+    "std::int64_t": "getInt64",
+    "int64_t": "getInt64",
+    "std::uint64_t": "getUInt64",
+    "uint64_t": "getUInt64",
+    "bool": "getBoolean",
+    "double": "getDouble",
+    "float": "getDouble",
+}
+
+# Transaction modes: none and read_only run in autocommit, the others in a real transaction
+SQL_TRANSACTIONS = ["none", "read_only", "read_write", "serializable"]
+
+# Result mappings each return type allows, the first one is the default. stream is never one:
+# it changes the method's parameters, so a query only gets it with an explicit result: stream
+SQL_RESULTS = {
+    "std::optional<std::string>": ["scalar"],
+    "std::optional<int>": ["scalar", "affected"],
+    "std::optional<bool>": ["scalar", "exists"],
+    "void": ["none"],
+    "bool": ["exists", "scalar"],
+    "int": ["scalar", "affected"],
+    "std::string": ["scalar"],
+    "std::vector<std::string>": ["column"],
+    "std::size_t": ["affected", "scalar", "stream"],
+}
+
+# Result mappings of a query returning rows of its declared row struct
+SQL_ROW_RESULTS = {
+    "std::vector<{}>": ["rows"],
+    "std::optional<{}>": ["row"],
+}
+
+# Sink every stream query takes after its own parameters, rows delivered are returned
+STREAM_SINK = ("const repository::RowSink&", "sink")
+
+# Rows MariaDB reads off the socket at a time for a stream query, the result set is never buffered
+STREAM_FETCH_ROWS = 1000
+
+# Table a bulk ingest writes to, optionally schema qualified
+INGEST_TABLE = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*(\.[A-Za-z_][A-Za-z0-9_]*)?$")
+
+# Most placeholders MySQL takes in one statement, caps the rows of a multi-row INSERT
+MYSQL_MAX_PLACEHOLDERS = 65535
+
+# Coalescing defaults for coalesce: true, first call waits the window or until the keys cap closes it
+COALESCE_WINDOW_US = 200
+COALESCE_MAX_KEYS = 64
+
+
 class QueryDefinitionParser:
     """Parses and validates query definitions from YAML files."""
 
@@ -98,6 +183,180 @@ class QueryDefinitionParser:
         key_behavior = "REQUIRED" if required else "OPTIONAL"
         return auth_type, env_var, key_behavior
 
+    def _parse_sql(
+        self, name: str, sql_config: Any, parameters: List[Dict]
+    ) -> Dict[str, str]:
+        """Spread declarative SQL over the backends and check its placeholders."""
+        if not sql_config:
+            return {}
+
+        if isinstance(sql_config, str):
+            sql = {backend: sql_config for backend in SQL_BACKENDS}
+        else:
+            sql = {b: sql_config[b] for b in SQL_BACKENDS if sql_config.get(b)}
+
+        param_types = {
+            param["name"]: sql_param_type(param["type"]) for param in parameters
+        }
+
+        for backend, text in sql.items():
+            for placeholder in SQL_PLACEHOLDER.findall(text):
+                if placeholder not in param_types:
+                    raise QueryDefinitionError(
+                        f"SQL of query '{name}' for {backend} binds :{placeholder} "
+                        "which is not one of its parameters."
+                    )
+
+        for param_name, param_type in param_types.items():
+            if param_type not in SQL_SETTERS:
+                raise QueryDefinitionError(
+                    f"Parameter '{param_name}' of query '{name}' has type "
+                    f"'{param_type}' which declarative SQL can't bind. "
+                    "Use one of: " + ", ".join(SQL_SETTERS) + "."
+                )
+
+        return sql
+
+    def _parse_row(
+        self, name: str, row: Optional[Dict], return_type: str, ingest: bool
+    ) -> Dict[str, Any]:
+        """Check a declared row struct and that return_type is a vector or an optional of it."""
+        if not row:
+            return {}
+
+        row_name = row.get("name", "").strip()
+        returns = (["std::size_t"] if ingest
+                   else [shape.format(row_name) for shape in SQL_ROW_RESULTS])
+
+        if return_type not in returns:
+            raise QueryDefinitionError(
+                f"Query '{name}' declares row '{row_name}' but returns '{return_type}'. "
+                "Must be one of: " + ", ".join(returns) + "."
+            )
+
+        columns = []
+        for column in row.get("columns", []):
+            column_type = column.get("type", "").strip()
+            column_name = column.get("name", "").strip()
+
+            if sql_column_type(column_type) not in SQL_GETTERS:
+                raise QueryDefinitionError(
+                    f"Column '{column_name}' of row '{row_name}' has type '{column_type}' "
+                    "which can't be decoded. Use one of: " + ", ".join(SQL_GETTERS) +
+                    ", or std::optional of one of them for a nullable column."
+                )
+
+            columns.append((column_type, column_name))
+
+        if not columns or len({n for _, n in columns}) != len(columns):
+            raise QueryDefinitionError(
+                f"Row '{row_name}' of query '{name}' needs columns with unique names."
+            )
+
+        return {"name": row_name, "columns": columns}
+
+    def _parse_result(
+        self, name: str, result: Optional[str], return_type: str, row: Dict[str, Any]
+    ) -> str:
+        """Pick the result mapping for declarative SQL and check it fits return_type."""
+        allowed = SQL_RESULTS.get(return_type)
+
+        if row:
+            allowed = next(
+                results for shape, results in SQL_ROW_RESULTS.items()
+                if shape.format(row["name"]) == return_type
+            )
+
+        if not allowed:
+            raise QueryDefinitionError(
+                f"Query '{name}' returns '{return_type}' which declarative SQL can't map."
+            )
+
+        if not result:
+            return allowed[0]
+
+        if result not in allowed:
+            raise QueryDefinitionError(
+                f"Invalid result '{result}' for query '{name}' returning "
+                f"'{return_type}'. Must be one of: {', '.join(allowed)}."
+            )
+
+        return result
+
+    def _parse_batchable(
+        self, name: str, sql: Dict[str, str], result: str,
+        parameters: List[Dict], return_type: str
+    ) -> None:
+        """Check a batchable query is a single-key lookup its batch variant can be derived from."""
+        if not sql or result != "scalar" or not return_type.startswith("std::optional<"):
+            raise QueryDefinitionError(
+                f"Query '{name}' is batchable but is not a lookup: it needs sql, "
+                "result: scalar and a std::optional return type."
+            )
+
+        if len(parameters) != 1:
+            raise QueryDefinitionError(
+                f"Query '{name}' is batchable but takes {len(parameters)} parameters, "
+                "a lookup takes its key only."
+            )
+
+        key = parameters[0]["name"].strip()
+
+        for backend, text in sql.items():
+            if sql_batch_split(text, key) is None:
+                raise QueryDefinitionError(
+                    f"SQL of batchable query '{name}' for {backend} must be a SELECT "
+                    f"without LIMIT that uses :{key} once, as <column> = :{key}."
+                )
+
+    def _parse_coalesce(self, name: str, coalesce: Any, batchable: bool) -> Dict[str, int]:
+        """Normalize coalesce to its window and key cap, empty when the query isn't coalesced."""
+        if coalesce is False:
+            return {}
+
+        if not batchable:
+            raise QueryDefinitionError(
+                f"Query '{name}' is coalesced but not batchable: "
+                "coalescing merges calls into its _batch variant."
+            )
+
+        options = {} if coalesce is True else coalesce
+
+        if not isinstance(options, dict):
+            raise QueryDefinitionError(
+                f"Invalid coalesce '{coalesce}' for query '{name}'. "
+                "Must be true, false or {window_us, max_keys}."
+            )
+
+        window_us = options.get("window_us", COALESCE_WINDOW_US)
+        max_keys = options.get("max_keys", COALESCE_MAX_KEYS)
+
+        for field, value in (("window_us", window_us), ("max_keys", max_keys)):
+            if not isinstance(value, int) or isinstance(value, bool) or value < 1:
+                raise QueryDefinitionError(
+                    f"Invalid coalesce {field} '{value}' for query '{name}'. "
+                    "Must be a positive integer."
+                )
+
+        return {"window_us": window_us, "max_keys": max_keys}
+
+    def _parse_ingest(
+        self, name: str, table: str, row: Dict[str, Any], sql: Dict[str, str],
+        parameters: List[Dict], access: str
+    ) -> None:
+        """Check a bulk ingest: rows of its declared struct written to a table, nothing else."""
+        if not INGEST_TABLE.match(table):
+            raise QueryDefinitionError(
+                f"Invalid ingest table '{table}' for query '{name}'. "
+                "Must be a table name, optionally schema qualified."
+            )
+
+        if not row or sql or parameters or access != "write":
+            raise QueryDefinitionError(
+                f"Query '{name}' ingests into '{table}' so it needs a row, "
+                "access: write, and no sql nor parameters: it takes the rows only."
+            )
+
     def _infer_category_from_name(self, name: str) -> str:
         """Infer category from method name for backward compatibility."""
         if name.startswith("IQuery_Example_"):
@@ -130,10 +389,103 @@ class QueryDefinitionParser:
             # Get enabled flag (default: true)
             enabled = query_data.get("enabled", True)
 
+            # Routing: reads may go to a replica, anything else runs on the primary
+            access = query_data.get("access", "write").strip().lower()
+
+            if access not in ["read", "write"]:
+                raise QueryDefinitionError(
+                    f"Invalid access '{access}' for query '{name}'. "
+                    "Must be 'read' or 'write'."
+                )
+
+            # Bulkhead: cap on concurrent calls and connections kept for this query, 0 = none
+            max_concurrency = query_data.get("max_concurrency", 0)
+            reserved = query_data.get("reserved", 0)
+
+            for field, value in (("max_concurrency", max_concurrency), ("reserved", reserved)):
+                if not isinstance(value, int) or isinstance(value, bool) or value < 0:
+                    raise QueryDefinitionError(
+                        f"Invalid {field} '{value}' for query '{name}'. "
+                        "Must be a positive integer."
+                    )
+
+            if max_concurrency and reserved > max_concurrency:
+                raise QueryDefinitionError(
+                    f"Query '{name}' reserves {reserved} connections "
+                    f"but may only run {max_concurrency} at once."
+                )
+
             # Parse parameters
             parameters = query_data.get("parameters", [])
             full_params, call_params = self._parse_parameters(parameters)
 
+            # Declarative SQL: the generator writes the backend implementation
+            return_type = query_data.get("return_type", "").strip()
+            sql = self._parse_sql(name, query_data.get("sql"), parameters)
+
+            # Row struct: named, typed columns decoded by index, no string round trip
+            ingest = query_data.get("ingest", "").strip()
+            row = self._parse_row(name, query_data.get("row"), return_type, bool(ingest))
+
+            result = (
+                self._parse_result(name, query_data.get("result"), return_type, row)
+                if sql else ""
+            )
+
+            # Bulk ingest: a vector of rows written in one COPY or in batches of DBINGESTBATCH rows
+            if ingest:
+                self._parse_ingest(name, ingest, row, sql, parameters, access)
+                result = "ingest"
+                full_params = f"const std::vector<{row['name']}>& rows"
+                call_params = "rows"
+
+            # Batch variant: many keys per call, one round trip to the cache and one to the database
+            batchable = query_data.get("batchable", False)
+            cache = query_data.get("cache") or {}
+
+            if batchable:
+                self._parse_batchable(name, sql, result, parameters, return_type)
+
+            # Stream: rows handed to a sink one at a time instead of returned all at once
+            if result == "stream":
+                full_params = ", ".join(filter(None, [full_params, " ".join(STREAM_SINK)]))
+                call_params = ", ".join(filter(None, [call_params, STREAM_SINK[1]]))
+
+            # Coalescing: concurrent single-key calls merged into one call of the batch variant
+            coalesce = self._parse_coalesce(name, query_data.get("coalesce", False), batchable)
+
+            # Single flight: identical calls in flight at once share the first one's result
+            single_flight = query_data.get("single_flight", False)
+
+            if single_flight and (access != "read" or return_type == "void" or result == "stream"):
+                raise QueryDefinitionError(
+                    f"Query '{name}' uses single_flight but only reads returning a value, "
+                    "not a stream, can share their result with identical calls."
+                )
+
+            if single_flight and coalesce:
+                raise QueryDefinitionError(
+                    f"Query '{name}' uses both single_flight and coalesce, "
+                    "coalesce already looks each key up once."
+                )
+
+            # Transaction mode of the generated code, replicas only take the autocommit ones
+            transaction = query_data.get(
+                "transaction", "read_only" if access == "read" else "read_write"
+            )
+
+            if transaction not in SQL_TRANSACTIONS:
+                raise QueryDefinitionError(
+                    f"Invalid transaction '{transaction}' for query '{name}'. "
+                    "Must be one of: " + ", ".join(SQL_TRANSACTIONS) + "."
+                )
+
+            if access == "read" and transaction in ("read_write", "serializable"):
+                raise QueryDefinitionError(
+                    f"Query '{name}' has access: read and may run on a replica, "
+                    f"it can't use transaction: {transaction}."
+                )
+
             # Parse authentication
             auth_config = query_data.get("authentication")
             auth_type, env_var_name, key_behavior = self._parse_authentication(
@@ -142,14 +494,30 @@ class QueryDefinitionParser:
 
             return {
                 "name": name,
-                "return_type": query_data.get("return_type", "").strip(),
+                "return_type": return_type,
                 "full_params": full_params,
                 "call_params": call_params,
+                "parameters": [
+                    (sql_param_type(param["type"]), param["name"].strip())
+                    for param in parameters
+                ],
                 "auth_type": auth_type,
                 "env_var_name": env_var_name,
                 "key_behavior": key_behavior,
                 "enabled": enabled,
                 "category": category,
+                "access": access,
+                "max_concurrency": max_concurrency,
+                "reserved": reserved,
+                "sql": sql,
+                "result": result,
+                "transaction": transaction,
+                "row": row,
+                "ingest": ingest,
+                "batchable": batchable,
+                "cache": cache,
+                "coalesce": coalesce,
+                "single_flight": single_flight,
                 "original_data": query_data,  # Keep for error reporting
             }
 
@@ -241,7 +609,7 @@ def validate_query_enablement(
 
 
 def convert_to_legacy_format(queries: List[Dict[str, Any]]) -> List[Dict[str, str]]:
-    """Convert enriched query format to legacy 7-field format for generators."""
+    """Convert enriched query format to legacy 19-field format for generators."""
     legacy_queries = []
 
     for query in queries:
@@ -253,11 +621,67 @@ def convert_to_legacy_format(queries: List[Dict[str, Any]]) -> List[Dict[str, st
             "auth_type": query["auth_type"],
             "env_var_name": query["env_var_name"],
             "key_behavior": query["key_behavior"],
+            "access": query["access"],
+            "max_concurrency": query["max_concurrency"],
+            "reserved": query["reserved"],
+            "parameters": query["parameters"],
+            "sql": query["sql"],
+            "result": query["result"],
+            "transaction": query["transaction"],
+            "row": query["row"],
+            "ingest": query["ingest"],
+            "batch": None,
+            "coalesce": query["coalesce"],
+            "single_flight": query["single_flight"],
         })
 
+        if query["batchable"]:
+            legacy_queries.append(batch_variant(legacy_queries[-1], query["cache"]))
+
+            if query["coalesce"]:
+                # Every call goes through _batch, which took the reservation over
+                legacy_queries[-2]["reserved"] = 0
+
     return legacy_queries
 
 
+def batch_variant(query: Dict[str, Any], cache: Dict[str, Any]) -> Dict[str, Any]:
+    """Derive the _batch variant of a lookup: a vector of keys in, their values in the same order out."""
+    key_type, key_name = query["parameters"][0]
+
+    return {
+        "return_type": f"std::vector<{query['return_type']}>",
+        "method_name": f"{query['method_name']}_batch",
+        "full_params": f"const std::vector<{key_type}>& {key_name}",
+        "call_params": key_name,
+        "auth_type": query["auth_type"],
+        "env_var_name": query["env_var_name"],
+        "key_behavior": query["key_behavior"],
+        "access": query["access"],
+        "max_concurrency": query["max_concurrency"],
+        # A coalesced lookup only ever runs as _batch, which then holds its reservation
+        "reserved": query["reserved"] if query["coalesce"] else 0,
+        "parameters": [],
+        "sql": {},
+        "result": "",
+        "transaction": query["transaction"],
+        "row": {},
+        "ingest": "",
+        "batch": {
+            "key_type": key_type,
+            "key_name": key_name,
+            "value_type": sql_value_type(query["return_type"]),
+            "sql": {
+                backend: sql_batch_split(text, key_name)
+                for backend, text in query["sql"].items()
+            },
+            "cache": cache,
+        },
+        "coalesce": {},
+        "single_flight": False,
+    }
+
+
 def detect_query_conflicts(
     core_queries: List[Dict[str, Any]],
     custom_queries: List[Dict[str, Any]],
@@ -287,6 +711,55 @@ def detect_query_conflicts(
         )
 
 
+def generate_query_rows(queries):
+    """Generate the row structs queries declare, one per name."""
+    logger.debug("Generating Query_Rows.hpp")
+    lines = []
+    lines.append("// Auto-generated file - DO NOT EDIT MANUALLY")
+    lines.append("// Combines core CAOSDBA queries and custom queries")
+    lines.append("#ifndef QUERY_ROWS_HPP")
+    lines.append("#define QUERY_ROWS_HPP")
+    lines.append("")
+
+    rows = {}
+    for query in queries:
+        row = query["row"]
+        if not row:
+            continue
+
+        # Queries may share a row struct as long as they declare it the same way
+        if row["name"] in rows and rows[row["name"]] != row["columns"]:
+            raise QueryDefinitionError(
+                f"Row '{row['name']}' of query '{query['method_name']}' is declared "
+                "with other columns by another query."
+            )
+        rows[row["name"]] = row["columns"]
+
+    if rows:
+        lines.append("#include <cstdint>")
+        lines.append("#include <optional>")
+        lines.append("#include <string>")
+        lines.append("")
+
+        for name, columns in rows.items():
+            width = max(len(column_type) for column_type, _ in columns)
+            lines.append(f"struct {name}")
+            lines.append("{")
+            for column_type, column_name in columns:
+                # Scalars start zeroed, what a NULL leaves them at
+                nullable = column_type != sql_column_type(column_type)
+                value = "" if nullable or column_type == "std::string" else " {}"
+                lines.append(f"  {column_type.ljust(width)} {column_name}{value};")
+            lines.append("};")
+            lines.append("")
+    else:
+        lines.append("// No row structs declared")
+        lines.append("")
+
+    lines.append("#endif // QUERY_ROWS_HPP")
+    return "\n".join(lines)
+
+
 def generate_query_definition(queries):
     """Generate macro for pure virtual definitions in IQuery."""
     logger.debug("Generating Query_Definition.hpp")
@@ -353,7 +826,12 @@ def generate_cache_forwarding(queries):
         lines.append("#define QUERY_FORWARDING_CACHE() \\")
         for i, query in enumerate(queries):
             method_line = f"    {query['return_type']} Cache::{query['method_name']}({query['full_params']}) {{"
-            return_line = f"        return this->cache->{query['method_name']}({query['call_params']});"
+            if query["coalesce"]:
+                return_line = cache_coalesce_lines(query)
+            elif query["single_flight"]:
+                return_line = cache_single_flight_lines(query)
+            else:
+                return_line = f"        return this->cache->{query['method_name']}({query['call_params']});"
             end_line = "    }"
 
             full_line = method_line + " \\\n" + return_line + " \\\n" + end_line
@@ -369,6 +847,87 @@ def generate_cache_forwarding(queries):
     return "\n".join(lines)
 
 
+def cache_coalesce_lines(query) -> str:
+    """Body of a coalesced lookup: its calls wait together and share one call of the _batch variant."""
+    key_type, key_name = query["parameters"][0]
+    coalescer = f"Coalescer<{key_type}, {sql_value_type(query['return_type'])}>"
+
+    return " \\\n".join([
+        f"        static {coalescer} coalescer(std::chrono::microseconds({query['coalesce']['window_us']}), "
+        f"{query['coalesce']['max_keys']});",
+        f"        return coalescer.load({key_name}, [this](const std::vector<{key_type}>& keys) {{",
+        f"          return this->cache->{query['method_name']}_batch(keys);",
+        "        });",
+    ])
+
+
+def cache_single_flight_lines(query) -> str:
+    """Body of a single-flight read: identical calls in flight wait for the first one's result."""
+    flight = f"SingleFlight<{query['return_type']}>"
+
+    return " \\\n".join([
+        f"        static {flight} flight;",
+        f"        return flight.run({flight}::key({query['call_params']}), [&]() {{",
+        f"          return this->cache->{query['method_name']}({query['call_params']});",
+        "        });",
+    ])
+
+
+def generate_cache_async(queries):
+    """Generate the _async variants of every query, run on the Cache executor."""
+    logger.debug("Generating Cache_Query_Async.hpp")
+    lines = []
+    lines.append("// Auto-generated file - DO NOT EDIT MANUALLY")
+    lines.append("// Combines core CAOSDBA queries and custom queries")
+    lines.append("#ifndef CACHE_QUERY_ASYNC_HPP")
+    lines.append("#define CACHE_QUERY_ASYNC_HPP")
+    lines.append("")
+
+    if queries:
+        declarations = []
+        definitions = []
+
+        for query in queries:
+            future = f"std::future<{query['return_type']}>"
+            with_done = ", ".join(filter(None, [query["full_params"], f"std::function<void({future})> done"]))
+            capture = ", ".join(filter(None, ["this", query["call_params"]]))
+            submit = f"this->executor->submit([{capture}]() {{"
+            call = f"    return this->{query['method_name']}({query['call_params']});"
+
+            declarations.append(f"    [[nodiscard]] {future} {query['method_name']}_async({query['full_params']});")
+            declarations.append(f"    void {query['method_name']}_async({with_done});")
+
+            definitions.append([
+                f"{future} Cache::{query['method_name']}_async({query['full_params']})",
+                "{",
+                f"  return {submit}",
+                call,
+                "  });",
+                "}",
+            ])
+            definitions.append([
+                f"void Cache::{query['method_name']}_async({with_done})",
+                "{",
+                f"  {submit}",
+                call,
+                "  }, std::move(done));",
+                "}",
+            ])
+
+        lines.append("#define QUERY_ASYNC_DECLARATION() \\")
+        lines.append(" \\\n".join(declarations))
+        lines.append("")
+        lines += macro_lines("QUERY_ASYNC_CACHE()", definitions)
+    else:
+        lines.append("// No queries defined")
+        lines.append("#define QUERY_ASYNC_DECLARATION()")
+        lines.append("#define QUERY_ASYNC_CACHE()")
+        lines.append("")
+
+    lines.append("#endif // CACHE_QUERY_ASYNC_HPP")
+    return "\n".join(lines)
+
+
 def generate_database_forwarding(queries):
     """Generate forwarding implementations for Database."""
     logger.debug("Generating Database_Query_Forwarding.hpp")
@@ -379,14 +938,31 @@ def generate_database_forwarding(queries):
     lines.append("#define DATABASE_QUERY_FORWARDING_HPP")
     lines.append("")
 
+    # Connections the pool keeps apart for queries declaring a reserved share
+    reserved = sum(query["reserved"] for query in queries)
+    lines.append(f"#define QUERY_RESERVED_CONNECTIONS {reserved}")
+    lines.append("")
+
     if queries:
         lines.append("#define QUERY_FORWARDING_DATABASE() \\")
         for i, query in enumerate(queries):
             method_line = f"    {query['return_type']} Database::{query['method_name']}({query['full_params']}) {{"
+            route_line = "        Database::RouteScope route(Database::Access::Read);"
+            bulkhead_line = (
+                f"        static Database::Bulkhead bulkhead(\"{query['method_name']}\", "
+                f"{query['max_concurrency']}, {query['reserved']});"
+            )
+            permit_line = "        Database::BulkheadScope permit(*this, bulkhead);"
             return_line = f"        return this->database->{query['method_name']}({query['call_params']});"
             end_line = "    }"
 
-            full_line = method_line + " \\\n" + return_line + " \\\n" + end_line
+            full_line = method_line + " \\\n"
+            if query["access"] == "read":
+                full_line += route_line + " \\\n"
+            # Once anything is reserved every query needs a permit, or the others could take it
+            if query["max_concurrency"] or reserved:
+                full_line += bulkhead_line + " \\\n" + permit_line + " \\\n"
+            full_line += return_line + " \\\n" + end_line
             if i < len(queries) - 1:
                 full_line += " \\"
             lines.append(full_line)
@@ -399,6 +975,1009 @@ def generate_database_forwarding(queries):
     return "\n".join(lines)
 
 
+def sql_param_type(param_type: str) -> str:
+    """Bare C++ type of a parameter, without const and reference."""
+    bare = re.sub(r"\bconst\b|&", " ", param_type)
+    return " ".join(bare.split())
+
+
+def sql_column_type(column_type: str) -> str:
+    """Type a row column is decoded as, e.g. int for std::optional<int>."""
+    match = re.match(r"std::optional<(.*)>$", column_type)
+    return match.group(1).strip() if match else column_type
+
+
+def sql_literal(sql: str, strip: bool = True) -> str:
+    """Quote SQL as a C++ string literal."""
+    escaped = (
+        (sql.strip() if strip else sql)
+        .replace("\\", "\\\\")
+        .replace('"', '\\"')
+        .replace("\n", "\\n")
+        .replace("\t", "\\t")
+    )
+    return f'"{escaped}"'
+
+
+def sql_bind(sql: str, parameters: List[Tuple[str, str]], backend: str):
+    """Swap :name placeholders for the backend's own, with the parameters to bind in order."""
+    names = [name for _, name in parameters]
+
+    if backend == "postgresql":
+        # $n follows the parameter list, a parameter used twice is bound once
+        used = sorted(
+            {names.index(n) for n in SQL_PLACEHOLDER.findall(sql)}
+        )
+        numbers = {names[index]: number + 1 for number, index in enumerate(used)}
+        text = SQL_PLACEHOLDER.sub(lambda m: f"${numbers[m.group(1)]}", sql)
+        return text, [parameters[index] for index in used]
+
+    # ? is positional, every occurrence is bound
+    types = dict((name, type_) for type_, name in parameters)
+    bound = [(types[n], n) for n in SQL_PLACEHOLDER.findall(sql)]
+    return SQL_PLACEHOLDER.sub("?", sql), bound
+
+
+def sql_quoted(sql: str) -> str:
+    """C++ expression building SQL with every :name placeholder replaced by tx.quote(name)."""
+    parts = SQL_PLACEHOLDER.split(sql.strip())
+    pieces = [
+        f"tx.quote({part})" if odd else sql_literal(part, strip=False)
+        for odd, part in ((i % 2 == 1, part) for i, part in enumerate(parts))
+        if odd or part
+    ]
+    # The first piece must be a std::string for + to concatenate literals
+    if pieces[0].startswith('"'):
+        pieces[0] = f"std::string({pieces[0]})"
+    return " + ".join(pieces)
+
+
+def sql_batch_split(sql: str, key: str) -> Optional[Tuple[str, str]]:
+    """Split a lookup around <column> = :key, the key column added in front of the select list."""
+    select = re.match(r"\s*SELECT\s+(?:DISTINCT\s+)?", sql, re.I)
+    lookup = list(re.finditer(rf"([\w.\"`]+)\s*=\s*:{key}\b", sql))
+
+    if (
+        not select
+        or len(lookup) != 1
+        or len(SQL_PLACEHOLDER.findall(sql)) != 1
+        or re.search(r"\bLIMIT\b", sql, re.I)
+    ):
+        return None
+
+    column = lookup[0].group(1)
+    head = sql[:select.end()] + f"{column}, " + sql[select.end():lookup[0].start()] + column
+    return head.strip(), sql[lookup[0].end():].rstrip()
+
+
+def sql_failure_return(return_type: str) -> str:
+    """Statement returning from a query called while shutting down."""
+    if return_type == "void":
+        return "return;"
+    if return_type.startswith("std::optional<"):
+        return "return std::nullopt;"
+    return "return {};"
+
+
+def sql_value_type(return_type: str) -> str:
+    """Type of a single value in the result, e.g. std::string for std::optional<std::string>."""
+    match = re.match(r"std::(?:optional|vector)<(.*)>$", return_type)
+    return match.group(1) if match else return_type
+
+
+def postgresql_transaction(query) -> Tuple[str, List[str]]:
+    """pqxx transaction type for the query's transaction mode, and its commit if it has one."""
+    # nontransaction sends no BEGIN/COMMIT, work is READ COMMITTED like the server default
+    transaction = {
+        "none": "pqxx::nontransaction",
+        "read_only": "pqxx::nontransaction",
+        "read_write": "pqxx::work",
+        "serializable": "pqxx::transaction<pqxx::isolation_level::serializable>",
+    }[query["transaction"]]
+    commit = ["  tx.commit();"] if query["transaction"] in ("read_write", "serializable") else []
+
+    return transaction, commit
+
+
+def generate_postgresql_body(query) -> List[str]:
+    """Body of a PostgreSQL method generated from declarative SQL."""
+    if query["result"] == "stream":
+        return generate_postgresql_stream_body(query)
+    if query["result"] == "ingest":
+        return generate_postgresql_ingest_body(query)
+
+    sql, bound = sql_bind(query["sql"]["postgresql"], query["parameters"], "postgresql")
+    result = query["result"]
+    value_type = sql_value_type(query["return_type"])
+    optional = query["return_type"].startswith("std::optional<")
+
+    transaction, commit = postgresql_transaction(query)
+
+    body = [
+        f'const pqxx::prepped statement = connection.prepared("{query["method_name"]}", {sql_literal(sql)});',
+        "",
+        "pqxx::params p;",
+    ]
+    body += [f"p.append({name});" for _, name in bound]
+    body += [
+        "",
+        "pqxx::result result;",
+        "",
+        "{",
+        f"  {transaction} tx(*connection);",
+        "  result = tx.exec(statement, p);",
+    ] + commit + [
+        "}",
+        "",
+    ]
+
+    if result == "none":
+        pass
+    elif result == "affected":
+        body.append(f"return static_cast<{value_type}>(result.affected_rows());")
+    elif result == "exists":
+        body.append("return !result.empty();")
+    elif result == "rows":
+        body += [
+            f"{query['return_type']} rows;",
+            "rows.reserve(result.size());",
+            "",
+            "for (const pqxx::row& row : result)",
+            "{",
+            f"  {value_type}& item = rows.emplace_back();",
+            "",
+        ]
+        body += [f"  {line}" if line else "" for line in postgresql_row_decode(query["row"])]
+        body += [
+            "}",
+            "",
+            "return rows;",
+        ]
+    elif result == "row":
+        body += [
+            "if (result.empty())",
+            "{",
+            "  return std::nullopt;",
+            "}",
+            "",
+            "const pqxx::row row = result[0];",
+            "",
+            f"{value_type} item;",
+            "",
+        ]
+        body += postgresql_row_decode(query["row"])
+        body += [
+            "",
+            "return item;",
+        ]
+    elif result == "column":
+        body += [
+            "std::vector<std::string> values;",
+            "values.reserve(result.size());",
+            "",
+            "for (const pqxx::row& row : result)",
+            "{",
+            "  values.push_back(row[0].is_null() ? std::string{} : row[0].as<std::string>());",
+            "}",
+            "",
+            "return values;",
+        ]
+    else:
+        missing = "std::nullopt" if optional else "{}"
+        body += [
+            "if (result.empty() || result[0][0].is_null())",
+            "{",
+            f"  return {missing};",
+            "}",
+            "",
+            f"return result[0][0].as<{value_type}>();",
+        ]
+
+    return body
+
+
+def postgresql_row_decode(row) -> List[str]:
+    """Fill item from pqxx row by column index, a NULL leaves the member at its default."""
+    lines = []
+    for index, (column_type, column_name) in enumerate(row["columns"]):
+        if lines:
+            lines.append("")
+        lines += [
+            f"if (!row[{index}].is_null())",
+            "{",
+            f"  item.{column_name} = row[{index}].as<{sql_column_type(column_type)}>();",
+            "}",
+        ]
+    return lines
+
+
+def connector_row_decode(row) -> List[str]:
+    """Fill item from the current row of result by column index, a NULL leaves the member at its default."""
+    lines = []
+    for index, (column_type, column_name) in enumerate(row["columns"], start=1):
+        decoded = sql_column_type(column_type)
+        getter = f"result->{SQL_GETTERS[decoded]}({index})"
+        if lines:
+            lines.append("")
+        lines += [
+            f"if (!result->isNull({index}))",
+            "{",
+        ]
+        if decoded == "std::string":
+            lines += [
+                f"  std::string value = {getter};",
+                f"  item.{column_name} = std::move(value);",
+            ]
+        elif decoded == "bool":
+            lines.append(f"  item.{column_name} = {getter};")
+        else:
+            lines.append(f"  item.{column_name} = static_cast<{decoded}>({getter});")
+        lines.append("}")
+    return lines
+
+
+def generate_postgresql_stream_body(query) -> List[str]:
+    """Body of a PostgreSQL stream query: COPY (query) TO STDOUT read a row at a time."""
+    transaction, commit = postgresql_transaction(query)
+
+    # COPY takes no bound parameters, they are quoted into the statement by the connection
+    return [
+        f"{transaction} tx(*connection);",
+        "",
+        f"pqxx::stream_from stream = pqxx::stream_from::query(tx, {sql_quoted(query['sql']['postgresql'])});",
+        "",
+        "repository::Row values;",
+        "std::size_t rows = 0;",
+        "",
+        "while (const std::vector<pqxx::zview>* fields = stream.read_row())",
+        "{",
+        "  values.resize(fields->size());",
+        "",
+        "  for (std::size_t i = 0; i < fields->size(); ++i)",
+        "  {",
+        "    const pqxx::zview& field = (*fields)[i];",
+        "",
+        "    if (field.data() == nullptr)",
+        "    {",
+        "      values[i].reset();",
+        "    }",
+        "    else if (values[i])",
+        "    {",
+        "      values[i]->assign(field.data(), field.size());",
+        "    }",
+        "    else",
+        "    {",
+        "      values[i].emplace(field.data(), field.size());",
+        "    }",
+        "  }",
+        "",
+        "  ++rows;",
+        "",
+        "  if (!sink(values))",
+        "  {",
+        "    break;",
+        "  }",
+        "}",
+        "",
+        "stream.complete();",
+    ] + [line.strip() for line in commit] + [
+        "",
+        "return rows;",
+    ]
+
+
+def generate_connector_stream_body(query, backend: str) -> List[str]:
+    """Body of a MySQL or MariaDB stream query: an unbuffered result set read a row at a time."""
+    sql, bound = sql_bind(query["sql"][backend], query["parameters"], backend)
+
+    # MySQL reads row by row off a forward-only result set, MariaDB when a fetch size is set
+    unbuffered = (
+        "pstmt.setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);"
+        if backend == "mysql"
+        else f"pstmt.setFetchSize({STREAM_FETCH_ROWS});"
+    )
+    prepare = [
+        f'sql::PreparedStatement& pstmt = connection.prepared("{query["method_name"]}", {sql_literal(sql)});',
+        unbuffered,
+        "",
+    ]
+    body = [
+        f"pstmt.{SQL_SETTERS[type_]}({index}, {name});"
+        for index, (type_, name) in enumerate(bound, start=1)
+    ]
+    if bound:
+        body.append("")
+
+    body += [
+        "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+        "",
+        "const unsigned int columns = result->getMetaData()->getColumnCount();",
+        "",
+        "repository::Row values(columns);",
+        "std::size_t rows = 0;",
+        "",
+        "while (result->next())",
+        "{",
+        "  for (unsigned int i = 0; i < columns; ++i)",
+        "  {",
+        "    if (result->isNull(i + 1))",
+        "    {",
+        "      values[i].reset();",
+        "    }",
+        "    else",
+        "    {",
+        "      std::string value = result->getString(i + 1);",
+        "      values[i] = std::move(value);",
+        "    }",
+        "  }",
+        "",
+        "  ++rows;",
+        "",
+        "  if (!sink(values))",
+        "  {",
+        "    break;",
+        "  }",
+        "}",
+        "",
+        "return rows;",
+    ]
+
+    return connector_transaction(query, prepare, body)
+
+
+def generate_postgresql_ingest_body(query) -> List[str]:
+    """Body of a PostgreSQL bulk ingest: every row in one COPY FROM STDIN."""
+    transaction, commit = postgresql_transaction(query)
+    row = query["row"]
+    table = ", ".join(f'"{part}"' for part in query["ingest"].split("."))
+    columns = ", ".join(f'"{column_name}"' for _, column_name in row["columns"])
+    values = ", ".join(f"row.{column_name}" for _, column_name in row["columns"])
+
+    # COPY has no statement size limit to batch for, a std::optional left empty goes in as NULL
+    return [
+        f"{transaction} tx(*connection);",
+        "",
+        f"pqxx::stream_to stream = pqxx::stream_to::table(tx, {{{table}}}, {{{columns}}});",
+        "",
+        f"for (const {row['name']}& row : rows)",
+        "{",
+        f"  stream.write_values({values});",
+        "}",
+        "",
+        "stream.complete();",
+    ] + [line.strip() for line in commit] + [
+        "",
+        "return rows.size();",
+    ]
+
+
+def connector_row_bind(row, at: str) -> List[str]:
+    """Bind the members of row to the statement's placeholders, at + 1 onwards."""
+    lines = []
+    for index, (column_type, column_name) in enumerate(row["columns"], start=1):
+        setter = SQL_SETTERS[sql_column_type(column_type)]
+        place = f"{at} + {index}" if at else str(index)
+
+        if column_type == sql_column_type(column_type):
+            lines.append(f"pstmt.{setter}({place}, row.{column_name});")
+            continue
+
+        if lines and lines[-1]:
+            lines.append("")
+        lines += [
+            f"if (row.{column_name})",
+            "{",
+            f"  pstmt.{setter}({place}, *row.{column_name});",
+            "}",
+            "else",
+            "{",
+            f"  pstmt.setNull({place}, sql::DataType::VARCHAR);",
+            "}",
+            "",
+        ]
+    while lines and not lines[-1]:
+        lines.pop()
+    return lines
+
+
+def generate_connector_ingest_body(query, backend: str) -> List[str]:
+    """Body of a MySQL or MariaDB bulk ingest, DBINGESTBATCH rows per statement."""
+    row = query["row"]
+    columns = ", ".join(column_name for _, column_name in row["columns"])
+    tuple_ = "(" + ", ".join("?" for _ in row["columns"]) + ")"
+    insert = f"INSERT INTO {query['ingest']} ({columns}) VALUES "
+
+    if backend == "mariadb":
+        # With useBulkStmts on the connection, executeBatch() sends the rows as one array binding
+        prepare = [
+            f'sql::PreparedStatement& pstmt = connection.prepared("{query["method_name"]}", {sql_literal(insert + tuple_)});',
+            "",
+        ]
+        body = [
+            "const std::size_t batch = this->database->ingestBatch();",
+            "",
+            "for (std::size_t i = 0; i < rows.size(); ++i)",
+            "{",
+            f"  const {row['name']}& row = rows[i];",
+            "",
+        ]
+        body += [f"  {line}" if line else "" for line in connector_row_bind(row, "")]
+        body += [
+            "",
+            "  pstmt.addBatch();",
+            "",
+            "  if ((i + 1) % batch == 0 || i + 1 == rows.size())",
+            "  {",
+            "    pstmt.executeBatch();",
+            "    pstmt.clearBatch();",
+            "  }",
+            "}",
+            "",
+            "return rows.size();",
+        ]
+        return connector_transaction(query, prepare, body)
+
+    # MySQL: one INSERT with a tuple per row, full batches reuse the statement cached on the connection
+    count = len(row["columns"])
+    body = [
+        "const auto insert = [](std::size_t count)",
+        "{",
+        f"  std::string statement = {sql_literal(insert, strip=False)};",
+        "",
+        "  for (std::size_t i = 0; i < count; ++i)",
+        "  {",
+        f'    statement += i == 0 ? "{tuple_}" : ", {tuple_}";',
+        "  }",
+        "",
+        "  return statement;",
+        "};",
+        "",
+        f"const std::size_t batch = std::min<std::size_t>(this->database->ingestBatch(), {MYSQL_MAX_PLACEHOLDERS // count});",
+        "",
+        "for (std::size_t done = 0; done < rows.size();)",
+        "{",
+        "  const std::size_t count = std::min(batch, rows.size() - done);",
+        "",
+        "  std::unique_ptr<sql::PreparedStatement> tail;",
+        "",
+        "  if (count < batch)",
+        "  {",
+        "    tail.reset(connection->prepareStatement(insert(count)));",
+        "  }",
+        "",
+        f'  sql::PreparedStatement& pstmt = tail ? *tail : connection.prepared("{query["method_name"]}", insert(batch));',
+        "",
+        "  for (std::size_t i = 0; i < count; ++i)",
+        "  {",
+        f"    const {row['name']}& row = rows[done + i];",
+        f"    const unsigned int at = static_cast<unsigned int>(i * {count});",
+        "",
+    ]
+    body += [f"    {line}" if line else "" for line in connector_row_bind(row, "at")]
+    body += [
+        "  }",
+        "",
+        "  pstmt.executeUpdate();",
+        "  done += count;",
+        "}",
+        "",
+        "return rows.size();",
+    ]
+    return connector_transaction(query, [], body)
+
+
+def generate_connector_body(query, backend: str) -> List[str]:
+    """Body of a MySQL or MariaDB method generated from declarative SQL."""
+    if query["result"] == "stream":
+        return generate_connector_stream_body(query, backend)
+    if query["result"] == "ingest":
+        return generate_connector_ingest_body(query, backend)
+
+    sql, bound = sql_bind(query["sql"][backend], query["parameters"], backend)
+    result = query["result"]
+    value_type = sql_value_type(query["return_type"])
+    optional = query["return_type"].startswith("std::optional<")
+    getter = {"std::string": "getString", "int": "getInt", "bool": "getBoolean", "std::size_t": "getUInt64"}[value_type] \
+        if result in ("scalar", "column") else ""
+
+    prepare = [
+        f'sql::PreparedStatement& pstmt = connection.prepared("{query["method_name"]}", {sql_literal(sql)});',
+        "",
+    ]
+    body = [
+        f"pstmt.{SQL_SETTERS[type_]}({index}, {name});"
+        for index, (type_, name) in enumerate(bound, start=1)
+    ]
+    if bound:
+        body.append("")
+
+    if result == "none":
+        body.append("pstmt.execute();")
+    elif result == "affected":
+        body.append(f"return static_cast<{value_type}>(pstmt.executeUpdate());")
+    elif result == "exists":
+        body += [
+            "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+            "",
+            "return result->next();",
+        ]
+    elif result == "rows":
+        body += [
+            "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+            "",
+            f"{query['return_type']} rows;",
+            "rows.reserve(result->rowsCount());",
+            "",
+            "while (result->next())",
+            "{",
+            f"  {value_type}& item = rows.emplace_back();",
+            "",
+        ]
+        body += [f"  {line}" if line else "" for line in connector_row_decode(query["row"])]
+        body += [
+            "}",
+            "",
+            "return rows;",
+        ]
+    elif result == "row":
+        body += [
+            "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+            "",
+            "if (!result->next())",
+            "{",
+            "  return std::nullopt;",
+            "}",
+            "",
+            f"{value_type} item;",
+            "",
+        ]
+        body += connector_row_decode(query["row"])
+        body += [
+            "",
+            "return item;",
+        ]
+    elif result == "column":
+        body += [
+            "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+            "",
+            "std::vector<std::string> values;",
+            "values.reserve(result->rowsCount());",
+            "",
+            "while (result->next())",
+            "{",
+            "  std::string value = result->getString(1);",
+            "  values.push_back(std::move(value));",
+            "}",
+            "",
+            "return values;",
+        ]
+    else:
+        missing = "std::nullopt" if optional else "{}"
+        body += [
+            "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+            "",
+            "if (!result->next() || result->isNull(1))",
+            "{",
+            f"  return {missing};",
+            "}",
+            "",
+            f"{value_type} value = result->{getter}(1);",
+            "",
+            "return value;",
+        ]
+
+    return connector_transaction(query, prepare, body)
+
+
+def connector_transaction(query, prepare: List[str], body: List[str]) -> List[str]:
+    """Run a MySQL or MariaDB body in the query's transaction mode."""
+    # A single statement in autocommit is its own transaction, no BEGIN/COMMIT round trips
+    if query["transaction"] in ("none", "read_only"):
+        return prepare + body
+
+    # START TRANSACTION leaves autocommit alone, so there is nothing to switch back after COMMIT
+    isolation = (
+        "sql::TRANSACTION_SERIALIZABLE"
+        if query["transaction"] == "serializable"
+        else "sql::TRANSACTION_READ_COMMITTED"
+    )
+    wrapped = prepare + [
+        f"connection.isolation({isolation});",
+        "",
+        "std::unique_ptr<sql::Statement> tx(connection->createStatement());",
+        'tx->execute("START TRANSACTION");',
+        "",
+        "try",
+        "{",
+    ]
+    if query["return_type"] == "void":
+        wrapped += [f"  {line}" if line else "" for line in body]
+        wrapped += ['  tx->execute("COMMIT");']
+    else:
+        wrapped += [f"  {query['return_type']} returnValue = [&]() -> {query['return_type']}", "  {"]
+        wrapped += [f"    {line}" if line else "" for line in body]
+        wrapped += [
+            "  }();",
+            "",
+            '  tx->execute("COMMIT");',
+            "",
+            "  return returnValue;",
+        ]
+    wrapped += [
+        "}",
+        "catch (...)",
+        "{",
+        '  try { tx->execute("ROLLBACK"); } catch (...) {}',
+        "  throw;",
+        "}",
+    ]
+
+    return wrapped
+
+
+def generate_postgresql_batch_body(query) -> List[str]:
+    """Body of a PostgreSQL _batch variant: every key in one = ANY($1) array parameter."""
+    batch = query["batch"]
+    head, tail = batch["sql"]["postgresql"]
+    key_type, key_name, value_type = batch["key_type"], batch["key_name"], batch["value_type"]
+    transaction, commit = postgresql_transaction(query)
+
+    return [
+        f'const pqxx::prepped statement = connection.prepared("{query["method_name"]}", {sql_literal(f"{head} = ANY($1){tail}")});',
+        "",
+        "pqxx::params p;",
+        f"p.append({key_name});",
+        "",
+        "pqxx::result result;",
+        "",
+        "{",
+        f"  {transaction} tx(*connection);",
+        "  result = tx.exec(statement, p);",
+    ] + commit + [
+        "}",
+        "",
+        f"std::unordered_map<{key_type}, {value_type}> found;",
+        "found.reserve(result.size());",
+        "",
+        "for (const pqxx::row& row : result)",
+        "{",
+        "  if (!row[0].is_null() && !row[1].is_null())",
+        "  {",
+        f"    found.emplace(row[0].as<{key_type}>(), row[1].as<{value_type}>());",
+        "  }",
+        "}",
+    ] + batch_in_order(query)
+
+
+def generate_connector_batch_body(query, backend: str) -> List[str]:
+    """Body of a MySQL or MariaDB _batch variant: every key in one IN (...) list."""
+    batch = query["batch"]
+    head, tail = batch["sql"][backend]
+    key_type, key_name, value_type = batch["key_type"], batch["key_name"], batch["value_type"]
+
+    # One statement per power of two keys, the tail repeats the last key: few statements to cache
+    prepare = [
+        "std::size_t width = 1;",
+        "",
+        f"while (width < {key_name}.size())",
+        "{",
+        "  width *= 2;",
+        "}",
+        "",
+        'std::string placeholders = "?";',
+        "",
+        "for (std::size_t i = 1; i < width; ++i)",
+        "{",
+        '  placeholders += ", ?";',
+        "}",
+        "",
+        "sql::PreparedStatement& pstmt = connection.prepared(",
+        f'  "{query["method_name"]}:" + std::to_string(width),',
+        f'  {sql_literal(head + " IN (")} + placeholders + {sql_literal(")" + tail)});',
+        "",
+    ]
+    body = [
+        "for (std::size_t i = 0; i < width; ++i)",
+        "{",
+        f"  pstmt.{SQL_SETTERS[key_type]}(static_cast<unsigned int>(i + 1), {key_name}[std::min(i, {key_name}.size() - 1)]);",
+        "}",
+        "",
+        "std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());",
+        "",
+        f"std::unordered_map<{key_type}, {value_type}> found;",
+        "found.reserve(result->rowsCount());",
+        "",
+        "while (result->next())",
+        "{",
+        "  if (!result->isNull(1) && !result->isNull(2))",
+        "  {",
+        f"    {key_type} key = result->{SQL_GETTERS[key_type]}(1);",
+        f"    {value_type} value = result->{SQL_GETTERS[value_type]}(2);",
+        "    found.emplace(std::move(key), std::move(value));",
+        "  }",
+        "}",
+    ] + batch_in_order(query)
+
+    return connector_transaction(query, prepare, body)
+
+
+def batch_in_order(query) -> List[str]:
+    """Values found by a _batch variant put back in the order of its keys."""
+    batch = query["batch"]
+    key_type, key_name = batch["key_type"], batch["key_name"]
+
+    return [
+        "",
+        f"{query['return_type']} values;",
+        f"values.reserve({key_name}.size());",
+        "",
+        f"for (const {key_type}& item : {key_name})",
+        "{",
+        "  auto it = found.find(item);",
+        "  values.push_back(it != found.end() ? std::make_optional(it->second) : std::nullopt);",
+        "}",
+        "",
+        "return values;",
+    ]
+
+
+def generate_database_implementation(queries):
+    """Generate backend implementations for queries declaring their SQL."""
+    logger.debug("Generating Database_Query_Implementation.hpp")
+    lines = []
+    lines.append("// Auto-generated file - DO NOT EDIT MANUALLY")
+    lines.append("// Combines core CAOSDBA queries and custom queries")
+    lines.append("#ifndef DATABASE_QUERY_IMPLEMENTATION_HPP")
+    lines.append("#define DATABASE_QUERY_IMPLEMENTATION_HPP")
+    lines.append("")
+
+    for backend, class_name in (
+        ("postgresql", "PostgreSQL"),
+        ("mysql", "MySQL"),
+        ("mariadb", "MariaDB"),
+    ):
+        macro = f"QUERY_IMPLEMENTATION_{backend.upper()}()"
+        declared = [
+            query for query in queries
+            if backend in query["sql"] or query["ingest"]
+            or (query["batch"] and backend in query["batch"]["sql"])
+        ]
+
+        if not declared:
+            lines.append(f"// No queries declare SQL for {class_name}")
+            lines.append(f"#define {macro}")
+            lines.append("")
+            continue
+
+        methods = []
+        for query in declared:
+            if backend == "postgresql":
+                body = (generate_postgresql_batch_body(query) if query["batch"]
+                        else generate_postgresql_body(query))
+                driver_error = "pqxx::broken_connection"
+            else:
+                body = (generate_connector_batch_body(query, backend) if query["batch"]
+                        else generate_connector_body(query, backend))
+                driver_error = "sql::SQLException"
+
+            method = [
+                f"{query['return_type']} {class_name}::{query['method_name']}({query['full_params']})",
+                "{",
+                "  if (!running.load(std::memory_order_relaxed))",
+                "  {",
+                (f"    return {query['return_type']}({query['batch']['key_name']}.size());"
+                 if query["batch"] else f"    {sql_failure_return(query['return_type'])}"),
+                "  }",
+                "",
+            ]
+            if query["batch"] or query["ingest"]:
+                method += [
+                    f"  if ({query['batch']['key_name'] if query['batch'] else 'rows'}.empty())",
+                    "  {",
+                    "    return {};",
+                    "  }",
+                    "",
+                ]
+            method += [
+                "  auto connection_opt = this->database->acquire();",
+                "",
+                "  if (!connection_opt)",
+                "  {",
+                '    throw repository::broken_connection("Database connection unavailable - cannot acquire connection from pool");',
+                "  }",
+                "",
+                "  Database::ConnectionWrapper& connection = connection_opt.value();",
+                "",
+                "  try",
+                "  {",
+            ]
+            while body and not body[-1]:
+                body.pop()
+            method += [f"    {line}" if line else "" for line in body]
+            method += [
+                "  }",
+                f"  catch (const {driver_error}& e)",
+                "  {",
+            ]
+            if backend == "postgresql":
+                method.append(
+                    f'    throw repository::broken_connection("{class_name} connection broken: " + std::string(e.what()));'
+                )
+            else:
+                # Client errors 2002, 2003, 2006, 2013 and 1927 mean the connection is gone
+                method += [
+                    "    const int errorCode = e.getErrorCode();",
+                    "",
+                    "    if (errorCode == 2002 || errorCode == 2003 || errorCode == 2006 || errorCode == 2013 || errorCode == 1927)",
+                    "    {",
+                    f'      throw repository::broken_connection("{class_name} connection broken: " + std::string(e.what()));',
+                    "    }",
+                    "",
+                    "    throw;",
+                ]
+            method += [
+                "  }",
+                "}",
+            ]
+            methods.append(method)
+
+        lines += macro_lines(macro, methods)
+
+    lines.append("#endif // DATABASE_QUERY_IMPLEMENTATION_HPP")
+    return "\n".join(lines)
+
+
+def macro_lines(macro: str, methods: List[List[str]]) -> List[str]:
+    """Method definitions joined into one multi-line macro."""
+    lines = [f"#define {macro} \\"]
+    flat = [line for method in methods for line in method + [""]][:-1]
+    for i, line in enumerate(flat):
+        text = f"  {line}" if line else ""
+        if i < len(flat) - 1:
+            text = f"{text} \\" if text else "\\"
+        lines.append(text)
+    lines.append("")
+    return lines
+
+
+def generate_cache_implementation(queries):
+    """Generate Redis implementations of the _batch variants, of the stream and ingest queries."""
+    logger.debug("Generating Cache_Query_Implementation.hpp")
+    lines = []
+    lines.append("// Auto-generated file - DO NOT EDIT MANUALLY")
+    lines.append("// Combines core CAOSDBA queries and custom queries")
+    lines.append("#ifndef CACHE_QUERY_IMPLEMENTATION_HPP")
+    lines.append("#define CACHE_QUERY_IMPLEMENTATION_HPP")
+    lines.append("")
+
+    methods = []
+    for query in queries:
+        # A stream or an ingest is never cached, the rows go straight between the database and the caller
+        if query["result"] in ("stream", "ingest"):
+            methods.append([
+                f"{query['return_type']} Redis::{query['method_name']}({query['full_params']})",
+                "{",
+                f"  return this->database->{query['method_name']}({query['call_params']});",
+                "}",
+            ])
+            continue
+
+        batch = query["batch"]
+        if not batch:
+            continue
+
+        name, key_name = query["method_name"], batch["key_name"]
+        cache = batch["cache"]
+        signature = f"{query['return_type']} Redis::{name}({query['full_params']})"
+
+        if not cache:
+            methods.append([
+                signature,
+                "{",
+                f"  return this->database->{name}({key_name});",
+                "}",
+            ])
+            continue
+
+        prefix = sql_literal(cache["prefix"])
+        ttl = cache.get("ttl", 300)
+        cache_key = (f"{prefix} + item" if batch["key_type"] == "std::string"
+                     else f"{prefix} + std::to_string(item)")
+        decoded = {
+            "std::string": "*cached[i]",
+            "int": "std::stoi(*cached[i])",
+            "bool": '*cached[i] == "1"',
+        }[batch["value_type"]]
+        encoded = {
+            "std::string": "*values[at]",
+            "int": "std::to_string(*values[at])",
+            "bool": '*values[at] ? "1" : "0"',
+        }[batch["value_type"]]
+
+        methods.append([
+            signature,
+            "{",
+            f'  static constexpr const char* fName = "Redis::{name}";',
+            "",
+            f"  {query['return_type']} values({key_name}.size());",
+            "",
+            "  std::vector<std::string> keys;",
+            f"  keys.reserve({key_name}.size());",
+            "",
+            f"  for (const {batch['key_type']}& item : {key_name})",
+            "  {",
+            f"    keys.push_back({cache_key});",
+            "  }",
+            "",
+            "  std::vector<sw::redis::OptionalString> cached;",
+            "  cached.reserve(keys.size());",
+            "",
+            "  try",
+            "  {",
+            "    this->redis->mget(keys.begin(), keys.end(), std::back_inserter(cached));",
+            "  }",
+            "  catch (const sw::redis::Error& e)",
+            "  {",
+            '    spdlog::error("[{}] Redis error: {}", fName, e.what());',
+            "    cached.assign(keys.size(), sw::redis::OptionalString{});",
+            "  }",
+            "",
+            f"  std::vector<{batch['key_type']}> misses;",
+            "  std::vector<std::size_t> missing;",
+            "",
+            "  for (std::size_t i = 0; i < keys.size(); ++i)",
+            "  {",
+            "    if (cached[i])",
+            "    {",
+            f"      values[i] = {decoded};",
+            "    }",
+            "    else",
+            "    {",
+            f"      misses.push_back({key_name}[i]);",
+            "      missing.push_back(i);",
+            "    }",
+            "  }",
+            "",
+            "  if (misses.empty())",
+            "  {",
+            "    return values;",
+            "  }",
+            "",
+            f"  {query['return_type']} fills = this->database->{name}(misses);",
+            "",
+            "  for (std::size_t j = 0; j < missing.size(); ++j)",
+            "  {",
+            "    values[missing[j]] = std::move(fills[j]);",
+            "  }",
+            "",
+            "  std::vector<std::pair<std::string, std::string>> entries;",
+            "  entries.reserve(missing.size());",
+            "",
+            "  for (std::size_t at : missing)",
+            "  {",
+            "    if (values[at].has_value())",
+            "    {",
+            f"      entries.emplace_back(keys[at], {encoded});",
+            "    }",
+            "  }",
+            "",
+            f"  this->fill(std::move(entries), std::chrono::seconds({ttl}));",
+            "",
+            "  return values;",
+            "}",
+        ])
+
+    if methods:
+        lines += macro_lines("QUERY_IMPLEMENTATION_REDIS()", methods)
+    else:
+        lines.append("// No batch variants, stream nor ingest queries")
+        lines.append("#define QUERY_IMPLEMENTATION_REDIS()")
+        lines.append("")
+
+    lines.append("#endif // CACHE_QUERY_IMPLEMENTATION_HPP")
+    return "\n".join(lines)
+
+
 def generate_auth_config(queries):
     """Generate authentication configuration."""
     logger.debug("Generating AuthConfig.hpp")
@@ -636,6 +2215,11 @@ def main() -> int:
         # Generate all files
         logger.info("Generating files...")
 
+        (output_dir / "Query_Rows.hpp").write_text(
+            generate_query_rows(enabled_legacy_queries)
+        )
+        logger.info("✓ Generated: Query_Rows.hpp")
+
         (output_dir / "Query_Definition.hpp").write_text(
             generate_query_definition(enabled_legacy_queries)
         )
@@ -651,11 +2235,26 @@ def main() -> int:
         )
         logger.info("✓ Generated: Cache_Query_Forwarding.hpp")
 
+        (output_dir / "Cache_Query_Async.hpp").write_text(
+            generate_cache_async(enabled_legacy_queries)
+        )
+        logger.info("✓ Generated: Cache_Query_Async.hpp")
+
+        (output_dir / "Cache_Query_Implementation.hpp").write_text(
+            generate_cache_implementation(enabled_legacy_queries)
+        )
+        logger.info("✓ Generated: Cache_Query_Implementation.hpp")
+
         (output_dir / "Database_Query_Forwarding.hpp").write_text(
             generate_database_forwarding(enabled_legacy_queries)
         )
         logger.info("✓ Generated: Database_Query_Forwarding.hpp")
 
+        (output_dir / "Database_Query_Implementation.hpp").write_text(
+            generate_database_implementation(enabled_legacy_queries)
+        )
+        logger.info("✓ Generated: Database_Query_Implementation.hpp")
+
         (output_dir / "AuthConfig.hpp").write_text(
             generate_auth_config(enabled_legacy_queries)
         )
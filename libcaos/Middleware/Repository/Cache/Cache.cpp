@@ -23,13 +23,15 @@ constexpr const char* defaultFinal = "{} : Setting cache {} to {} in {} environm
 Cache::Cache(std::unique_ptr<IRepository> db_)
   : database_(std::move(db_)),
     pool(std::make_unique<Pool>()),
-    cache(pool->init(database_))
+    executor(pool->initExecutor()),
+    cache(pool->init(database_, executor.get()))
 {
 }
 
 Cache::~Cache()
 {
   spdlog::trace("Destroying Cache");
+  this->executor.reset();                                                                           // Queued _async calls still use the layers below
   this->database_.reset();
   this->pool.reset();
   this->cache.reset();
@@ -48,6 +50,25 @@ Cache::~Cache()
 
 
 
+#ifdef CAOS_USE_CACHE_REDIS
+std::future<sw::redis::OptionalString> Cache::getAsync(const std::string& key)
+{
+  return static_cast<Redis&>(*this->cache).getAsync(key);
+}
+
+
+
+void Cache::getAsync(const std::string& key, std::function<void(std::future<sw::redis::OptionalString>)> done)
+{
+  static_cast<Redis&>(*this->cache).getAsync(key, std::move(done));
+}
+#endif
+
+
+
+
+
+
 
 
 
@@ -465,13 +486,79 @@ void Cache::Pool::setPoolConnectionIdletime()
 
 
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Cache::Pool::setExecutorThreads()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Cache::Pool::setExecutorThreads()
+{
+  const char* fName     = "Cache::Pool::setExecutorThreads"         ;
+  const char* fieldName = "CACHEEXECUTORTHREADS"                    ;
+  using dataType        = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_CACHEEXECUTORTHREADS_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.executorthreads,                                   // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_CACHEEXECUTORTHREADS_ENV_NAME,                             // envName
+    CAOS_CACHEEXECUTORTHREADS_OPT_NAME,                             // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Cache::Pool::setExecutorThreads()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Cache::Pool::setExecutorQueue()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Cache::Pool::setExecutorQueue()
+{
+  const char* fName     = "Cache::Pool::setExecutorQueue"           ;
+  const char* fieldName = "CACHEEXECUTORQUEUE"                      ;
+  using dataType        = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_CACHEEXECUTORQUEUE_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.executorqueue,                                     // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_CACHEEXECUTORQUEUE_ENV_NAME,                               // envName
+    CAOS_CACHEEXECUTORQUEUE_OPT_NAME,                               // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Cache::Pool::setExecutorQueue()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Init of Cache::Pool::init()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 #ifdef CAOS_USE_CACHE_REDIS
-std::unique_ptr<IRepository> Cache::Pool::init(std::unique_ptr<IRepository>& database)
+std::unique_ptr<IRepository> Cache::Pool::init(std::unique_ptr<IRepository>& database, Executor* executor)
 {
-  return std::make_unique<Redis>(database, this->getConnectOpt(), this->getPoolOpt());
+  return std::make_unique<Redis>(database, this->getConnectOpt(), this->getPoolOpt(), executor, this->getExecutorQueue());
 }
 #endif
 // -------------------------------------------------------------------------------------------------
@@ -481,6 +568,20 @@ std::unique_ptr<IRepository> Cache::Pool::init(std::unique_ptr<IRepository>& dat
 
 
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Cache::Pool::initExecutor()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::unique_ptr<Executor> Cache::Pool::initExecutor() const
+{
+  return std::make_unique<Executor>(this->getExecutorThreads(), this->getExecutorQueue());
+}
+// -------------------------------------------------------------------------------------------------
+// End of Cache::Pool::initExecutor()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
 
 const std::string&                Cache::Pool::getUser()                    const noexcept { return this->config.user;                    }
 const std::string&                Cache::Pool::getPass()                    const noexcept { return this->config.pass;                    }
@@ -495,3 +596,5 @@ const std::chrono::milliseconds&  Cache::Pool::getPoolWait()                cons
 const std::chrono::milliseconds&  Cache::Pool::getPoolConnectionTimeout()   const noexcept { return this->config.poolconnectiontimeout;   }
 const std::chrono::seconds&       Cache::Pool::getPoolConnectionLifetime()  const noexcept { return this->config.poolconnectionlifetime;  }
 const std::chrono::milliseconds&  Cache::Pool::getPoolConnectionIdletime()  const noexcept { return this->config.poolconnectionidletime;  }
+const std::size_t&                Cache::Pool::getExecutorThreads()         const noexcept { return this->config.executorthreads;         }
+const std::size_t&                Cache::Pool::getExecutorQueue()           const noexcept { return this->config.executorqueue;           }
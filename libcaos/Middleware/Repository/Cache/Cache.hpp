@@ -1,7 +1,11 @@
 #pragma once
 
 #include "../IRepository.hpp"
+#include "../Executor.hpp"
+#include "Coalescer.hpp"
+#include "SingleFlight.hpp"
 #include "generated_queries/Query_Override.hpp"
+#include "generated_queries/Cache_Query_Async.hpp"
 
 #ifdef CAOS_USE_CACHE_REDIS
 #include <sw/redis++/redis++.h>
@@ -28,6 +32,8 @@ class Cache : public IRepository
           std::chrono::milliseconds                   poolconnectiontimeout {CAOS_CACHEPOOLCONNECTIONTIMEOUT};
           std::chrono::seconds                        poolconnectionlifetime{CAOS_CACHEPOOLCONNECTIONLIFETIME};
           std::chrono::milliseconds                   poolconnectionidletime{CAOS_CACHEPOOLCONNECTIONIDLETIME};
+          std::size_t                                 executorthreads       {CAOS_CACHEEXECUTORTHREADS};
+          std::size_t                                 executorqueue         {CAOS_CACHEEXECUTORQUEUE};
 #ifdef CAOS_USE_CACHE_REDIS
           sw::redis::ConnectionOptions                connection_options                        ;
           sw::redis::ConnectionPoolOptions            pool_options                              ;
@@ -49,6 +55,8 @@ class Cache : public IRepository
         void                                          setPoolConnectionTimeout()                ;
         void                                          setPoolConnectionLifetime()               ;
         void                                          setPoolConnectionIdletime()               ;
+        void                                          setExecutorThreads()                      ;
+        void                                          setExecutorQueue()                        ;
 #ifdef CAOS_USE_CACHE_REDIS
         void                                          setConnectOpt()                   noexcept;
         void                                          setPoolOpt()                      noexcept;
@@ -68,6 +76,8 @@ class Cache : public IRepository
         [[nodiscard]] const std::chrono::milliseconds&getPoolConnectionTimeout()  const noexcept;
         [[nodiscard]] const std::chrono::seconds&     getPoolConnectionLifetime() const noexcept;
         [[nodiscard]] const std::chrono::milliseconds&getPoolConnectionIdletime() const noexcept;
+        [[nodiscard]] const std::size_t&              getExecutorThreads()        const noexcept;
+        [[nodiscard]] const std::size_t&              getExecutorQueue()          const noexcept;
 #ifdef CAOS_USE_CACHE_REDIS
         [[nodiscard]] const sw::redis::ConnectionOptions getConnectOpt()          const noexcept;
         [[nodiscard]] const sw::redis::ConnectionPoolOptions getPoolOpt()         const noexcept;
@@ -101,17 +111,22 @@ class Cache : public IRepository
           this->setPoolConnectionLifetime() ;
           this->setPoolConnectionIdletime() ;
 
+          this->setExecutorThreads()        ;
+          this->setExecutorQueue()          ;
+
 #ifdef CAOS_USE_CACHE_REDIS
           this->setConnectOpt()             ;
           this->setPoolOpt()                ;
 #endif
         };
-        [[nodiscard]] std::unique_ptr<IRepository> init(std::unique_ptr<IRepository>&);
+        [[nodiscard]] std::unique_ptr<IRepository> init(std::unique_ptr<IRepository>&, Executor*);
+        [[nodiscard]] std::unique_ptr<Executor>    initExecutor() const;
         ~Pool() = default;
     };
 
     std::unique_ptr<IRepository> database_;
     std::unique_ptr<Pool>        pool;
+    std::unique_ptr<Executor>    executor;                                                          // Runs the _async variants
     std::unique_ptr<IRepository> cache;
 
   public:
@@ -121,8 +136,16 @@ class Cache : public IRepository
 
     std::unique_ptr<IRepository>& database() { return this->database_; }
 
+#ifdef CAOS_USE_CACHE_REDIS
+    // GET that doesn't block the caller, see Redis::getAsync()
+    [[nodiscard]] std::future<sw::redis::OptionalString> getAsync(const std::string& key);
+    void getAsync(const std::string& key, std::function<void(std::future<sw::redis::OptionalString>)> done);
+#endif
+
     QUERY_OVERRIDE() /* <- from "generated_queries/Query_Override.hpp" */
 
     // Manually insert your query override here
 
+    QUERY_ASYNC_DECLARATION() /* <- from "generated_queries/Cache_Query_Async.hpp" */
+
 };
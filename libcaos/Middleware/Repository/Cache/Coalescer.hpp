@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// Micro-batching of concurrent single-key lookups, the dataloader pattern.
+//
+// The first caller to arrive opens a group and waits up to the window, or until the group holds
+// maxKeys keys, while later callers add their key to it. Then the first caller closes the group,
+// runs one batch lookup for all of its keys and hands every waiting caller its own value. A key
+// asked twice in the same group is looked up once. No thread of its own: the opening caller does
+// the work.
+template <typename Key, typename Value>
+class Coalescer
+{
+  public:
+    using Batch = std::function<std::vector<std::optional<Value>>(const std::vector<Key>&)>;     // Values in key order
+
+    Coalescer(std::chrono::microseconds window, std::size_t maxKeys)
+      : window(window),
+        maxKeys(std::max<std::size_t>(maxKeys, 1))
+    {}
+
+    Coalescer(const Coalescer&)            = delete;
+    Coalescer& operator=(const Coalescer&) = delete;
+
+    // Value of key as returned by batch for the whole group. Rethrows what batch threw
+    [[nodiscard]] std::optional<Value> load(const Key& key, const Batch& batch)
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+
+      if (this->open)
+      {
+        std::shared_ptr<Group> group = this->open;
+        const std::size_t      index = group->add(key);
+
+        if (group->keys.size() >= this->maxKeys)
+        {
+          this->open.reset();                                                                       // Full, nobody else joins
+          group->cv.notify_all();                                                                   // Opener stops waiting
+        }
+
+        group->cv.wait(lock, [&group]() { return group->done; });
+
+        return group->result(index);
+      }
+
+      std::shared_ptr<Group> group = std::make_shared<Group>();
+      group->add(key);
+      this->open = group;
+
+      if (this->maxKeys > 1)
+      {
+        group->cv.wait_for(lock, this->window, [this, &group]() { return this->open != group; });
+      }
+
+      if (this->open == group)
+      {
+        this->open.reset();
+      }
+
+      lock.unlock();
+
+      try
+      {
+        group->values = batch(group->keys);
+
+        if (group->values.size() != group->keys.size())
+        {
+          throw std::length_error("Coalescer batch returned a value count other than its key count");
+        }
+      }
+      catch (...)
+      {
+        group->error = std::current_exception();
+      }
+
+      lock.lock();
+      group->done = true;
+      group->cv.notify_all();
+
+      return group->result(0);
+    }
+
+  private:
+    struct Group
+    {
+      std::vector<Key>                                keys                                      ;
+      std::vector<std::optional<Value>>               values                                    ;
+      std::exception_ptr                              error                                     ;
+      bool                                            done                  {false}             ;
+      std::condition_variable                         cv                                        ;
+
+      std::size_t add(const Key& key)
+      {
+        const auto it = std::find(this->keys.begin(), this->keys.end(), key);
+
+        if (it != this->keys.end())
+        {
+          return static_cast<std::size_t>(it - this->keys.begin());
+        }
+
+        this->keys.push_back(key);
+
+        return this->keys.size() - 1;
+      }
+
+      std::optional<Value> result(std::size_t index) const
+      {
+        if (this->error)
+        {
+          std::rethrow_exception(this->error);
+        }
+
+        return this->values[index];
+      }
+    };
+
+    const std::chrono::microseconds                   window                                    ;
+    const std::size_t                                 maxKeys                                   ;
+
+    std::mutex                                        mutex                                     ;
+    std::shared_ptr<Group>                            open                                      ;     // Accepting keys, if any
+};
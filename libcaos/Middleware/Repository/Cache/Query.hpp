@@ -5,4 +5,6 @@
 
 QUERY_FORWARDING_CACHE() /* <- from "generated_queries/Cache_Query_Forwarding.hpp" */
 
+QUERY_ASYNC_CACHE() /* <- from "generated_queries/Cache_Query_Async.hpp" */
+
 // Manually insert your cache forwarding here
@@ -8,6 +8,10 @@
 #include "../../src/include/Cache/Redis/Query.hpp"
 #endif
 
+#include "generated_queries/Cache_Query_Implementation.hpp"
+
+QUERY_IMPLEMENTATION_REDIS() /* <- from "generated_queries/Cache_Query_Implementation.hpp" */
+
 
 
 
@@ -23,9 +27,15 @@
  *
  *
  **************************************************************************************************/
-Redis::Redis(std::unique_ptr<IRepository>& database_, const sw::redis::ConnectionOptions& connectOpt, const sw::redis::ConnectionPoolOptions& poolOpt)
+Redis::Redis(std::unique_ptr<IRepository>& database_, const sw::redis::ConnectionOptions& connectOpt, const sw::redis::ConnectionPoolOptions& poolOpt, Executor* executor_, [[maybe_unused]] std::size_t fillQueue)
   : database(database_),
-    redis(std::make_unique<sw::redis::Redis>(connectOpt, poolOpt))
+    redis(std::make_unique<sw::redis::Redis>(connectOpt, poolOpt)),
+    executor(executor_)
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+    , async(std::make_unique<sw::redis::AsyncRedis>(connectOpt, poolOpt))
+#else
+    , fills(std::make_unique<Executor>(1, fillQueue))
+#endif
 {
 }
 /***************************************************************************************************
@@ -45,6 +55,123 @@ Redis::Redis(std::unique_ptr<IRepository>& database_, const sw::redis::Connectio
 
 
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Redis::getAsync()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+Redis::Lookup Redis::getAsync(const std::string& key)
+{
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+  return this->async->get(key);
+#else
+  return this->executor->submit([this, key]() { return this->redis->get(key); });
+#endif
+}
+
+
+
+void Redis::getAsync(const std::string& key, std::function<void(Lookup)> done)
+{
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+  this->async->get(key, [done](Lookup&& result) { done(std::move(result)); });
+#else
+  this->executor->submit([this, key]() { return this->redis->get(key); }, std::move(done));
+#endif
+}
+// -------------------------------------------------------------------------------------------------
+// End of Redis::getAsync()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Redis::fill()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Redis::fill(const std::string& key, std::chrono::seconds ttl, const std::string& value)
+{
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+  this->async->setex(key, ttl.count(), value, [key](auto&& stored)
+  {
+    try
+    {
+      stored.get();
+    }
+    catch (const sw::redis::Error& e)
+    {
+      spdlog::warn("[Redis::fill] Failed to store {} in cache: {}", key, e.what());
+    }
+  });
+#else
+  this->fills->submit([this, key, ttl, value]() { this->redis->setex(key, ttl, value); }, [key](std::future<void> stored)
+  {
+    try
+    {
+      stored.get();
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::warn("[Redis::fill] Failed to store {} in cache: {}", key, e.what());
+    }
+  });
+#endif
+}
+
+
+
+// One pipeline for all the entries, on the AsyncRedis connection or on the fill thread
+void Redis::fill(std::vector<std::pair<std::string, std::string>> entries, std::chrono::seconds ttl)
+{
+  if (entries.empty())
+  {
+    return;
+  }
+
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+  for (const std::pair<std::string, std::string>& entry : entries)                                  // Sent back to back on the event loop
+  {
+    this->fill(entry.first, ttl, entry.second);
+  }
+#else
+  auto shared = std::make_shared<std::vector<std::pair<std::string, std::string>>>(std::move(entries));
+
+  this->fills->submit([this, shared, ttl]()
+  {
+    auto pipe = this->redis->pipeline(false);
+
+    for (const std::pair<std::string, std::string>& entry : *shared)
+    {
+      pipe.setex(entry.first, ttl, entry.second);
+    }
+
+    pipe.exec();
+  },
+  [count = shared->size()](std::future<void> stored)
+  {
+    try
+    {
+      stored.get();
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::warn("[Redis::fill] Failed to store {} entries in cache: {}", count, e.what());
+    }
+  });
+#endif
+}
+// -------------------------------------------------------------------------------------------------
+// End of Redis::fill()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
 void Cache::Pool::setConnectOpt() noexcept
 {
   sw::redis::ConnectionOptions options;
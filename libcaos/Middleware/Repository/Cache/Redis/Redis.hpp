@@ -1,14 +1,26 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "../Cache.hpp"
 #include "generated_queries/Query_Override.hpp"
 
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+#include <sw/redis++/async_redis++.h>
+#endif
+
 class Redis final : public IRepository
 {
   public:
-    Redis(std::unique_ptr<IRepository>&, const sw::redis::ConnectionOptions&, const sw::redis::ConnectionPoolOptions&);
+    using Lookup = std::future<sw::redis::OptionalString>;
+
+    Redis(std::unique_ptr<IRepository>&, const sw::redis::ConnectionOptions&, const sw::redis::ConnectionPoolOptions&, Executor*, std::size_t fillQueue);
 
     ~Redis() = default;
 
@@ -16,8 +28,26 @@ class Redis final : public IRepository
 
     // Manually insert your query override here
 
+    // Non-blocking GET: on AsyncRedis when built with CAOS_USE_CACHE_REDIS_ASYNC, on the query
+    // executor otherwise. done gets the ready future on the event loop or executor thread
+    [[nodiscard]] Lookup          getAsync(const std::string& key)                                  ;
+    void                          getAsync(const std::string& key, std::function<void(Lookup)> done);
+
+    // Fire-and-forget SETEX after a database miss: the caller doesn't wait for Redis and a failed
+    // or refused fill is only logged, the next miss fills again. Without AsyncRedis fills queue on
+    // an executor of their own, so a burst of them can't get _async calls refused
+    void                          fill(const std::string& key, std::chrono::seconds ttl, const std::string& value);
+    void                          fill(std::vector<std::pair<std::string, std::string>> entries, std::chrono::seconds ttl);
+
   private:
     Cache*                        cache;
     std::unique_ptr<IRepository>& database;
     std::unique_ptr<sw::redis::Redis> redis;
+    Executor*                     executor;                                                         // Owned by Cache
+
+#ifdef CAOS_USE_CACHE_REDIS_ASYNC
+    std::unique_ptr<sw::redis::AsyncRedis> async;
+#else
+    std::unique_ptr<Executor>     fills;                                                            // One thread, fillQueue fills at most
+#endif
 };
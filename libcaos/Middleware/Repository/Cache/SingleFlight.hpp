@@ -0,0 +1,119 @@
+#pragma once
+
+#include <exception>
+#include <fmt/format.h>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Single-flight deduplication of identical in-flight calls.
+//
+// Calls made with the same key while one of them is running don't run again: the first caller
+// runs the call and the others wait on a shared future for its result or its exception. The key
+// is dropped as soon as the call ends, so nothing is cached past the in-flight window.
+template <typename Value>
+class SingleFlight
+{
+  public:
+    SingleFlight()                               = default;
+    SingleFlight(const SingleFlight&)            = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    // Serialized arguments, each one length prefixed so that ("ab", "c") and ("a", "bc") differ
+    template <typename... Args>
+    [[nodiscard]] static std::string key(const Args&... args)
+    {
+      std::string serialized;
+
+      (append(serialized, args), ...);
+
+      return serialized;
+    }
+
+    template <typename Call>
+    [[nodiscard]] Value run(const std::string& key, Call&& call)
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+
+      const auto it = this->flights.find(key);
+
+      if (it != this->flights.end())
+      {
+        std::shared_future<Value> flight = it->second;
+        lock.unlock();
+
+        return flight.get();
+      }
+
+      std::promise<Value> promise;
+      this->flights.emplace(key, promise.get_future().share());
+      lock.unlock();
+
+      try
+      {
+        Value value = call();
+        promise.set_value(value);
+        this->land(key);
+
+        return value;
+      }
+      catch (...)
+      {
+        promise.set_exception(std::current_exception());
+        this->land(key);
+
+        throw;
+      }
+    }
+
+  private:
+    std::mutex                                        mutex                                     ;
+    std::unordered_map<std::string, std::shared_future<Value>> flights                          ;
+
+    void land(const std::string& key)
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->flights.erase(key);
+    }
+
+    template <typename Arg>
+    static void append(std::string& serialized, const Arg& arg)
+    {
+      if constexpr (std::is_convertible_v<const Arg&, std::string_view>)
+      {
+        const std::string_view text(arg);
+
+        serialized += std::to_string(text.size());
+        serialized += ':';
+        serialized.append(text.data(), text.size());
+      }
+      else if constexpr (std::is_floating_point_v<Arg>)
+      {
+        append(serialized, fmt::format("{}", arg));                                                  // Shortest round-trip form, to_string rounds to 6 decimals
+      }
+      else if constexpr (std::is_arithmetic_v<Arg>)
+      {
+        append(serialized, std::to_string(arg));
+      }
+      else if constexpr (std::is_enum_v<Arg>)
+      {
+        append(serialized, static_cast<std::underlying_type_t<Arg>>(arg));
+      }
+      else
+      {
+        serialized += std::to_string(arg.size());
+        serialized += '[';
+
+        for (const auto& element : arg)
+        {
+          append(serialized, element);
+        }
+
+        serialized += ']';
+      }
+    }
+};
@@ -2,6 +2,9 @@
 #include "Query.hpp"
 
 #include <arpa/inet.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 #ifdef CAOS_USE_DB_POSTGRESQL
 #include "PostgreSQL/PostgreSQL.hpp"
@@ -31,9 +34,8 @@ constexpr const char* defaultFinal = "{} : Setting database {} to {} in {} envir
  *
  *
  **************************************************************************************************/
-Database::Pool::Pool()
-  : connectionRefused(false),
-    config({})
+Database::Pool::Pool(const std::optional<Endpoint>& replica)
+  : config({})
 {
   if (this->terminalPtr==nullptr)
   {
@@ -46,6 +48,18 @@ Database::Pool::Pool()
   setPort()                 ;
   setName()                 ;
 
+  if (replica.has_value())                                                                          // Same settings, other server
+  {
+    this->config.host = replica->first;
+    this->config.port = replica->second;
+
+    spdlog::info("Read replica pool for {}:{}", this->getHost(), this->getPort());
+  }
+  else
+  {
+    setReplicas()           ;
+  }
+
   setPoolSizeMin()          ;
   setPoolSizeMax()          ;
   if (this->getPoolSizeMin() > this->getPoolSizeMax())
@@ -58,12 +72,27 @@ Database::Pool::Pool()
   setConnectTimeout()       ;
   setMaxWait()              ;
   setHealthCheckInterval()  ;
+  setConnectParallelism()   ;
+  setPoolShards()           ;
+  setThreadAffinity()       ;
+
+  setBreakerThreshold()     ;
+  setBreakerBackoffMin()    ;
+  setBreakerBackoffMax()    ;
+  if (this->getBreakerBackoffMin() > this->getBreakerBackoffMax())
+  {
+    throw std::out_of_range("DBBREAKERBACKOFFMIN > DBBREAKERBACKOFFMAX");
+  }
+
+  setIngestBatch()          ;
 
 #ifdef CAOS_USE_DB_POSTGRESQL
   setKeepAlives()           ;
   setKeepAlivesIdle()       ;
   setKeepAlivesInterval()   ;
   setKeepAlivesCount()      ;
+  setAsyncConnections()     ;
+  setAsyncQueue()           ;
   setConnectStr()           ;
 #endif
 
@@ -71,6 +100,18 @@ Database::Pool::Pool()
   setConnectOpt()           ;
 #endif
 
+  static std::atomic<std::uint64_t> pools {0};
+
+  this->id_   = pools.fetch_add(1, std::memory_order_relaxed) + 1;
+  this->data_ = std::make_unique<PoolData>(this->getPoolSizeMax(), this->getPoolShards());
+
+  for (std::size_t i = 0; i < this->getConnectParallelism(); ++i)
+  {
+    this->factoryThreads_.emplace_back([this]() {
+      this->connectionFactoryLoop();
+    });
+  }
+
   this->healthCheckThread_ = std::thread([this]() {
     this->healthCheckLoop();
   });
@@ -86,6 +127,19 @@ Database::Pool::~Pool()
 
   running.store(false, std::memory_order_release);
 
+  {
+    Database::Pool::PoolData& pool = this->getPoolData();
+
+    std::lock_guard<std::mutex> lock(pool.connections_mutex);
+
+    for (Waiter* waiter : pool.waiters)                                                             // Wake up parked requests
+    {
+      waiter->cv.notify_one();
+    }
+
+    this->factory_cv_.notify_all();
+  }
+
   this->condition.notify_all();
   this->shutdown_cv_.notify_all();
 
@@ -93,6 +147,14 @@ Database::Pool::~Pool()
   {
     this->healthCheckThread_.join();
   }
+
+  for (auto& factoryThread : this->factoryThreads_)                                                 // Waits for in-flight handshakes
+  {
+    if (factoryThread.joinable())
+    {
+      factoryThread.join();
+    }
+  }
 }
 /***************************************************************************************************
  *
@@ -500,6 +562,287 @@ void Database::Pool::setHealthCheckInterval()
 
 
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setConnectParallelism()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setConnectParallelism()
+{
+  const char* fName     = "Database::Pool::setConnectParallelism"   ;
+  const char* fieldName = "DBCONNECT_PARALLELISM"                   ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBCONNECT_PARALLELISM_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.connect_parallelism,                               // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBCONNECT_PARALLELISM_ENV_NAME,                            // envName
+    CAOS_DBCONNECT_PARALLELISM_OPT_NAME,                            // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setConnectParallelism()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setPoolShards()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setPoolShards()
+{
+  const char* fName     = "Database::Pool::setPoolShards"           ;
+  const char* fieldName = "DBPOOLSHARDS"                            ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBPOOLSHARDS_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.poolshards,                                        // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBPOOLSHARDS_ENV_NAME,                                     // envName
+    CAOS_DBPOOLSHARDS_OPT_NAME,                                     // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+
+  if (this->config.poolshards > this->getPoolSizeMax())                                             // Every shard owns a slot at least
+  {
+    spdlog::warn("[{}] {} shards for {} connections, using {}",
+                 fName, this->config.poolshards, this->getPoolSizeMax(), this->getPoolSizeMax());
+
+    this->config.poolshards = this->getPoolSizeMax();
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setPoolShards()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setThreadAffinity()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setThreadAffinity()
+{
+  const char* fName     = "Database::Pool::setThreadAffinity"       ;
+  const char* fieldName = "DBTHREADAFFINITY"                        ;
+  using       dataType  = std::chrono::milliseconds                 ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBTHREADAFFINITY_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType, std::uint32_t>(
+    this->config.threadAffinity,                                    // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBTHREADAFFINITY_ENV_NAME,                                 // envName
+    CAOS_DBTHREADAFFINITY_OPT_NAME,                                 // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setThreadAffinity()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setReplicas()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Read replicas share user, password, database name and pool settings with the primary. An entry
+// without a port uses DBPORT
+void Database::Pool::setReplicas()
+{
+  const char* fName     = "Database::Pool::setReplicas"             ;
+  const char* fieldName = "DBREPLICAS"                              ;
+  using       dataType  = std::string                               ;
+
+  Policy::EndpointListValidator validator(
+    fieldName,
+    this->config.replica_endpoints,
+    this->getPort()
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.replicas,                                          // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBREPLICAS_ENV_NAME,                                       // envName
+    CAOS_DBREPLICAS_OPT_NAME,                                       // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setReplicas()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setBreakerThreshold()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setBreakerThreshold()
+{
+  const char* fName     = "Database::Pool::setBreakerThreshold"     ;
+  const char* fieldName = "DBBREAKERTHRESHOLD"                      ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBBREAKERTHRESHOLD_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.breakerThreshold,                                  // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBBREAKERTHRESHOLD_ENV_NAME,                               // envName
+    CAOS_DBBREAKERTHRESHOLD_OPT_NAME,                               // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setBreakerThreshold()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setBreakerBackoffMin()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setBreakerBackoffMin()
+{
+  const char* fName     = "Database::Pool::setBreakerBackoffMin"    ;
+  const char* fieldName = "DBBREAKERBACKOFFMIN"                     ;
+  using       dataType  = std::chrono::milliseconds                 ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBBREAKERBACKOFFMIN_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType, std::uint32_t>(
+    this->config.breakerBackoffMin,                                 // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBBREAKERBACKOFFMIN_ENV_NAME,                              // envName
+    CAOS_DBBREAKERBACKOFFMIN_OPT_NAME,                              // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setBreakerBackoffMin()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setBreakerBackoffMax()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setBreakerBackoffMax()
+{
+  const char* fName     = "Database::Pool::setBreakerBackoffMax"    ;
+  const char* fieldName = "DBBREAKERBACKOFFMAX"                     ;
+  using       dataType  = std::chrono::milliseconds                 ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBBREAKERBACKOFFMAX_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType, std::uint32_t>(
+    this->config.breakerBackoffMax,                                 // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBBREAKERBACKOFFMAX_ENV_NAME,                              // envName
+    CAOS_DBBREAKERBACKOFFMAX_OPT_NAME,                              // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setBreakerBackoffMax()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setIngestBatch()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setIngestBatch()
+{
+  const char* fName     = "Database::Pool::setIngestBatch"          ;
+  const char* fieldName = "DBINGESTBATCH"                           ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBINGESTBATCH_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.ingestBatch,                                       // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBINGESTBATCH_ENV_NAME,                                    // envName
+    CAOS_DBINGESTBATCH_OPT_NAME,                                    // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setIngestBatch()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
 
 
 
@@ -522,6 +865,8 @@ const std::size_t&                Database::Pool::getKeepAlives()           cons
 const std::size_t&                Database::Pool::getKeepAlivesIdle()       const noexcept { return this->config.keepalives_idle;       }
 const std::size_t&                Database::Pool::getKeepAlivesInterval()   const noexcept { return this->config.keepalives_interval;   }
 const std::size_t&                Database::Pool::getKeepAlivesCount()      const noexcept { return this->config.keepalives_count;      }
+const std::size_t&                Database::Pool::getAsyncConnections()     const noexcept { return this->config.async_connections;     }
+const std::size_t&                Database::Pool::getAsyncQueue()           const noexcept { return this->config.async_queue;           }
 const std::string&                Database::Pool::getConnectStr()           const noexcept { return this->config.connection_string;     }
 #elif (defined(CAOS_USE_DB_MYSQL)||defined(CAOS_USE_DB_MARIADB))
       sql::ConnectOptionsMap&     Database::Pool::getConnectOpt()                 noexcept { return this->config.connection_options;    }
@@ -529,6 +874,16 @@ const std::string&                Database::Pool::getConnectStr()           cons
 
 const std::chrono::milliseconds&  Database::Pool::getMaxWait()              const noexcept { return this->config.maxwait;               }
 const std::chrono::milliseconds&  Database::Pool::getHealthCheckInterval()  const noexcept { return this->config.healthCheckInterval;   }
+const std::size_t&                Database::Pool::getConnectParallelism()   const noexcept { return this->config.connect_parallelism;   }
+const std::size_t&                Database::Pool::getPoolShards()           const noexcept { return this->config.poolshards;            }
+const std::chrono::milliseconds&  Database::Pool::getThreadAffinity()       const noexcept { return this->config.threadAffinity;        }
+const std::size_t&                Database::Pool::getBreakerThreshold()     const noexcept { return this->config.breakerThreshold;      }
+const std::chrono::milliseconds&  Database::Pool::getBreakerBackoffMin()    const noexcept { return this->config.breakerBackoffMin;     }
+const std::chrono::milliseconds&  Database::Pool::getBreakerBackoffMax()    const noexcept { return this->config.breakerBackoffMax;     }
+const std::size_t&                Database::Pool::getIngestBatch()          const noexcept { return this->config.ingestBatch;           }
+const std::vector<Database::Endpoint>& Database::Pool::getReplicas()       const noexcept { return this->config.replica_endpoints;     }
+std::size_t                       Database::Pool::getOutstanding()          const noexcept { return this->data_->outstanding.load(std::memory_order_relaxed); }
+bool                              Database::Pool::isReachable()             const noexcept { return this->data_->breaker.state.load() == Breaker::State::Closed && this->data_->breaker.failures.load() == 0; }
 
 
 
@@ -537,22 +892,32 @@ const std::chrono::milliseconds&  Database::Pool::getHealthCheckInterval()  cons
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::get_metrics()
+// Init of Database::Pool::getMetrics()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Database::Pool::Metrics Database::Pool::get_metrics() const noexcept
-// {
-//   std::lock_guard<std::mutex> lock(Database::Pool::available_mutex_);
+// Point-in-time view for monitoring. Every figure is read separately without stopping the pool, so
+// they may disagree by the few requests that were in flight.
+Database::Pool::Metrics Database::Pool::getMetrics()
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
 
-//   return Metrics
-//   {
-//     Database::Pool::available_.size(),
-//     total_known_.load(std::memory_order_relaxed),
-//     creations_.load(std::memory_order_relaxed),
-//     failures_.load(std::memory_order_relaxed),
-//   };
-// }
+  return Metrics
+  {
+    this->getAvailableConnections(),
+    pool.size(),
+    pool.creations.value(),
+    pool.creationFailures.value(),
+    pool.validationErrors.value(),
+    pool.acquireTimeouts.value(),
+    pool.acquireErrors.value(),
+    pool.breakerTrips.value(),
+    pool.waitTime.snapshot(),
+    pool.holdTime.snapshot(),
+    pool.createTime.snapshot(),
+    pool.validateTime.snapshot()
+  };
+}
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::get_metrics()
+// End of Database::Pool::getMetrics()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -570,24 +935,18 @@ const std::chrono::milliseconds&  Database::Pool::getHealthCheckInterval()  cons
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 std::size_t Database::Pool::getAvailableConnections() noexcept
 {
-  std::size_t count = 0;
-
   Database::Pool::PoolData& pool = this->getPoolData();
 
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+  std::size_t available = 0;
 
-  // Cerca la unique_ptr corrispondente nella mappa
-  for (auto it = pool.connections.begin(); it != pool.connections.end(); ++it)
+  for (Shard& shard : pool.shards)
   {
-    auto& metrics = it->second;
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-    if (!metrics.is_acquired)
-    {
-      count++;
-    }
+    available += shard.idle.size();
   }
 
-  return count;
+  return available;
 }
 // -------------------------------------------------------------------------------------------------
 // End of Database::Pool::getAvailableConnections()
@@ -608,11 +967,7 @@ std::size_t Database::Pool::getAvailableConnections() noexcept
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 std::size_t Database::Pool::getTotalConnections() noexcept
 {
-  Database::Pool::PoolData& pool = this->getPoolData();
-
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
-
-  return pool.connections.size();
+  return this->getPoolData().size();
 }
 // -------------------------------------------------------------------------------------------------
 // End of Database::Pool::getTotalConnections()
@@ -631,11 +986,14 @@ std::size_t Database::Pool::getTotalConnections() noexcept
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Init of Database::Pool::checkPoolSize()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex
 bool Database::Pool::checkPoolSize(std::size_t& askingPoolSize) noexcept
 {
   static constexpr const char* fName = "Database::Pool::checkPoolSize";
 
-  const std::size_t totalConnections  = this->getTotalConnections();
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const std::size_t totalConnections  = pool.size() + pool.pending + pool.opening;                 // Include in-flight handshakes
   const std::size_t poolSizeMax       = this->getPoolSizeMax();
 
   if (totalConnections >= poolSizeMax)  // Don't saturate Database connections
@@ -668,33 +1026,32 @@ bool Database::Pool::checkPoolSize(std::size_t& askingPoolSize) noexcept
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Init of Database::Pool::init()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. Queues new connections for the factory threads and
+// returns how many were queued: nothing is dialed here.
 std::size_t Database::Pool::init(std::size_t count)
 {
   static constexpr const char* fName = "Database::Pool::init";
 
-  std::size_t i = 0;
-  std::size_t pool_size = (count>0) ? count : this->getPoolSizeMin();
+  Database::Pool::PoolData& pool = this->getPoolData();
 
-  spdlog::info("[{}] New pool building", fName);
+  std::size_t pool_size = (count>0) ? count : this->getPoolSizeMin();
 
-  while (i < pool_size                                                                              // Create connections until the requested size is reached
-         && running.load(std::memory_order_acquire)                                                // Stop if a signal detected
-         && !this->connectionRefused.load(std::memory_order_acquire))                               // Stop if a previous connection was refused
+  if (!running.load(std::memory_order_acquire)                                                      // Stop if a signal detected
+      || pool.breaker.state.load(std::memory_order_acquire) != Breaker::State::Closed               // Only the breaker probe dials meanwhile
+      || !this->checkPoolSize(pool_size))                                                           // Don't saturate Database connections
   {
-    try
-    {
-      this->createConnection(pool_size);
-      spdlog::trace("[{}] New Database connection established", fName);
-    }
-    catch (const repository::broken_connection& e)
-    {
-      throw;
-    }
-
-    i++;
+    return 0;
   }
 
-  return i;
+  const std::size_t room   = this->getPoolSizeMax() - (pool.size() + pool.pending + pool.opening);
+  const std::size_t queued = std::min(pool_size, room);
+
+  spdlog::debug("[{}] Queued {} new connections", fName, queued);
+
+  pool.pending += queued;
+  this->factory_cv_.notify_all();
+
+  return queued;
 }
 // -------------------------------------------------------------------------------------------------
 // End of Database::Pool::init()
@@ -711,113 +1068,139 @@ std::size_t Database::Pool::init(std::size_t count)
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::getPoolData()
+// Init of Database::Pool::connectionFactoryLoop()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-Database::Pool::PoolData& Database::Pool::getPoolData() noexcept
+// DBCONNECT_PARALLELISM of these run side by side: each takes one queued request, reserves a vacant
+// slot for it, dials with the pool unlocked and hands the new connection to the oldest waiter (or to
+// the idle stack of the shard owning the slot).
+void Database::Pool::connectionFactoryLoop()
 {
-  static PoolData instance(this->getPoolSizeMax());
-  return instance;
-}
-// -------------------------------------------------------------------------------------------------
-// End of Database::Pool::getPoolData()
-// -------------------------------------------------------------------------------------------------
-// -------------------------------------------------------------------------------------------------
+  static constexpr const char* fName = "Database::Pool::connectionFactoryLoop";
+
+  Database::Pool::PoolData& pool = this->getPoolData();
 
+  std::unique_lock<std::mutex> lock(pool.connections_mutex);
 
+  while (true)
+  {
+    this->factory_cv_.wait(lock, [&pool]{
+      return pool.pending > 0 || !running.load(std::memory_order_acquire);
+    });
 
+    if (!running.load(std::memory_order_acquire))
+    {
+      break;
+    }
 
+    pool.pending--;
 
+    const std::optional<std::size_t> slot = this->reserveSlot();
 
+    if (!slot.has_value())
+    {
+      if (pool.breaker.state.load(std::memory_order_acquire) == Breaker::State::HalfOpen)
+      {
+        std::vector<dbuniq> dropped = this->tripBreaker();                                          // Probe lost, retry after a backoff
 
+        lock.unlock();
 
+        for (dbuniq& connection : dropped)
+        {
+          this->disconnect(connection);
+        }
 
+        lock.lock();
+      }
 
+      continue;                                                                                     // No room left
+    }
 
+    pool.opening++;
 
-// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::healthCheckLoop()
-// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::healthCheckLoop()
-{
-  static constexpr const char* fName = "Database::Pool::healthCheckLoop";
+    lock.unlock();
 
-  while (running.load(std::memory_order_acquire))
-  {
-    spdlog::trace("Running {}", fName);
+    dbuniq     connection;
+    bool       refused = false;
+    const auto dialed  = std::chrono::steady_clock::now();
 
+    try
+    {
+      connection = this->openConnection();
+    }
+    catch (const repository::broken_connection& e)
     {
-      Database::Pool::PoolData& pool = this->getPoolData();
+      spdlog::error("[{}] Database unreachable or port closed: {}", fName, e.what());
+      refused = true;
+    }
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex);
+    const bool created = (connection != nullptr);
 
-      try
-      {
-        if (!pool.connections.empty())
-        {
-          spdlog::debug("Performing health check on existing connections");
+    if (created)
+    {
+      pool.createTime.record(std::chrono::steady_clock::now() - dialed);
+      pool.creations.increment();
+    }
+    else
+    {
+      pool.creationFailures.increment();
+    }
 
-          for (auto it = pool.connections.begin(); it != pool.connections.end(); ++it)
-          {
-            auto& [connection, metrics] = *it;
+    lock.lock();
 
-            if (metrics.is_acquired)
-            {
-              continue;
-            }
+    {
+      Shard& shard = pool.shardOf(slot.value());
 
-            try
-            {
-              metrics.is_acquired = true;                                                         // Don't let threads acquire this connection while validating
+      std::lock_guard<std::mutex> shardLock(shard.mutex);
 
-              this->validateConnection(connection);
+      if (created)
+      {
+        this->insertConnection(slot.value(), std::move(connection));
+      }
+      else
+      {
+        shard.vacant.push_back(slot.value());                                                       // Give the reservation back
+      }
+    }
 
-              metrics.is_acquired = false;
+    pool.opening--;
 
-              spdlog::trace("[{}] Connection is valid", fName);
-            }
-            catch(...)
-            {
-              spdlog::info("[{}] Invalid connection marked for removal", fName);
-              spdlog::trace("[{}] Connection invalid", fName);
-              pool.connectionsToRemove.push_back(it);
-            }
-          }
-        }
+    if (created)
+    {
+      this->closeBreaker();
+      this->handOff();
 
-        this->cleanupMarkedConnections();                                                           // Remove invalid connections
+      spdlog::info("[{}] New valid connection created (total: {})", fName, pool.size());
+      continue;
+    }
 
-        std::size_t totalConnections = pool.connections.size();
+    if (refused)
+    {
+      pool.pending = 0;                                                                             // Server is down, drop the queue
+    }
 
-        int connectionDiff = static_cast<int>(totalConnections - this->getPoolSizeMin());
+    if ((pool.size() == 0 || pool.breaker.state.load() == Breaker::State::HalfOpen)                 // Live connections mean a full server, not a dead one
+        && this->countFailure())
+    {
+      std::vector<dbuniq> dropped = this->tripBreaker();
 
-        if (connectionDiff < 0)
-        {
-          this->init(static_cast<std::size_t>(-connectionDiff));                                    // Refill pool
-        }
-      }
-      catch (const repository::broken_connection& e)
+      lock.unlock();
+
+      for (dbuniq& connection : dropped)                                                            // Disconnect off the lock
       {
-        spdlog::error("[{}] Database unreachable or port closed", fName);
+        this->disconnect(connection);
       }
-    }
 
-    condition.notify_all();
+      lock.lock();
+    }
 
+    if (pool.size() == 0 && pool.pending == 0 && pool.opening == 0)
     {
-      std::unique_lock<std::mutex> waitlock(this->shutdown_mutex_);
-      shutdown_cv_.wait_for(
-            waitlock,
-            this->getHealthCheckInterval(),
-            [this]{
-                this->connectionRefused = false;
-                return !running.load(std::memory_order_acquire);
-            }
-      );
+      this->failWaiters();                                                                          // Nothing will ever be handed over
     }
   }
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::healthCheckLoop()
+// End of Database::Pool::connectionFactoryLoop()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -831,39 +1214,37 @@ void Database::Pool::healthCheckLoop()
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::calculateAverageDuration()
+// Init of Database::Pool::reserveSlot()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-std::chrono::milliseconds Database::Pool::calculateAverageDuration()
+// Caller must hold PoolData::connections_mutex. Takes a vacant slot for a connection about to be
+// dialed, walking the shards round-robin so every sub-pool gets its share of new connections.
+std::optional<std::size_t> Database::Pool::reserveSlot()
 {
-  std::chrono::milliseconds total_duration{0};
-  int total_operations = 0;
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const std::size_t shards = pool.shards.size();
 
+  for (std::size_t i = 0; i < shards; ++i)
   {
-    Database::Pool::PoolData& pool = this->getPoolData();
+    Shard& shard = pool.shards[(pool.nextShard + i) % shards];
 
-    std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
 
-    if (pool.connections.empty())
+    if (!shard.vacant.empty())
     {
-      return std::chrono::milliseconds(0);
-    }
+      const std::size_t index = shard.vacant.back();
+      shard.vacant.pop_back();
 
-    for (const auto& [connection, metrics] : pool.connections)
-    {
-      total_duration += metrics.total_duration;
-      total_operations += metrics.usage_count;
-    }
-  }
+      pool.nextShard = (pool.nextShard + i + 1) % shards;
 
-  if (total_operations == 0)
-  {
-    return std::chrono::milliseconds(0);
+      return index;
+    }
   }
 
-  return std::chrono::milliseconds(total_duration / total_operations);
+  return std::nullopt;
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::calculateAverageDuration()
+// End of Database::Pool::reserveSlot()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -877,104 +1258,38 @@ std::chrono::milliseconds Database::Pool::calculateAverageDuration()
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::acquireConnection()
+// Init of Database::Pool::getPoolData()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-#define INIT_CONNECTION()                         \
-  try                                             \
-  {                                               \
-    this->init(1);                                \
-  }                                               \
-  catch (const repository::broken_connection& e)  \
-  {                                               \
-    throw;                                        \
-  }
-
-dboptuniqptr Database::Pool::acquireConnection()
+Database::Pool::PoolData& Database::Pool::getPoolData() noexcept
 {
-  static constexpr const char* fName = "Database::Pool::acquireConnection";
-
-  if (!running.load(std::memory_order_acquire))
-  {
-    return std::nullopt;
-  }
-
-  {
-    Database::Pool::PoolData& pool = this->getPoolData();
-
-    std::unique_lock<std::mutex> lock(pool.connections_mutex);
-
-    if (pool.connections.empty())
-    {
-      // Pool is empty! Do not await healthCheckLoop(). Create emergency connection
-      INIT_CONNECTION()
-    }
-    else
-    {
-      for (auto it = pool.connections.begin(); it != pool.connections.end(); ++it)
-      {
-        const auto& connection  = it->first                                                   ;
-        auto&       metrics     = it->second                                                  ;
+  return *this->data_;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::getPoolData()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
 
-        if (!metrics.is_acquired)
-        {
-          try
-          {
-            #if CAOS_VALIDATE_CONNECTION_BEFORE_ACQUIRE==1
-            if (this->validateConnection(connection))
-            {
-            #else
-            if (connection->is_open())
-            {
-            #endif
-              auto now = std::chrono::steady_clock::now()                                     ;
-              metrics.start_time    = now                                                     ;
-              metrics.last_acquired = now                                                     ;
-              metrics.is_acquired   = true                                                    ;
-              metrics.usage_count++                                                           ;
-
-              return &connection                                                              ;
-            }
 
-            throw repository::broken_connection("Connection lost");
 
-          }
-          catch (const repository::broken_connection& e)
-          {
-            // Remove connection
-            pool.connectionsToRemove.push_back(it);
-            this->cleanupMarkedConnections();
 
-            throw;
-          }
-        }
-      }
 
-      // Pool count is not enough! Try to create an emergency connection
-      INIT_CONNECTION()
-    }
-  }
 
-  static std::atomic<std::size_t> limiter                                     {0}         ;
 
-  std::size_t current = limiter.fetch_add(1, std::memory_order_acq_rel) + 1               ;
 
-  if (current >= CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED)
-  {
-    std::size_t expected = current;
 
-    if (limiter.compare_exchange_strong(expected, 0,
-                                        std::memory_order_release,
-                                        std::memory_order_relaxed))
-    {
-      spdlog::warn("[{}] : Unable to acquire Database connection - {} failed requests (pool busy)", fName, current);
-      spdlog::info("[{}] : Database connection limit exceeded: reduce thread pool size or increase max_connections parameter", fName);
-    }
-  }
 
-  return std::nullopt;
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::homeShard()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Threads spread round-robin over the shards in the order threadNumber() numbered them, so a fixed
+// set of workers (Crow's thread pool) lands evenly and each worker keeps going back to the same
+// sub-pool.
+std::size_t Database::Pool::homeShard() const noexcept
+{
+  return threadNumber() % this->getPoolShards();
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::acquireConnection()
+// End of Database::Pool::homeShard()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -988,20 +1303,19 @@ dboptuniqptr Database::Pool::acquireConnection()
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::handleInvalidConnection()
+// Init of Database::Pool::threadNumber()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::handleInvalidConnection()
+// Small dense number of the calling thread, assigned on first use
+std::size_t Database::Pool::threadNumber() noexcept
 {
-  std::size_t newConnection = this->init(1);
+  static std::atomic<std::size_t> nextThread {0};
 
-  if (newConnection==1)
-  {
-    this->condition.notify_all();
-  }
+  thread_local const std::size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
 
+  return thread;
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::handleInvalidConnection()
+// End of Database::Pool::threadNumber()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -1014,39 +1328,62 @@ void Database::Pool::handleInvalidConnection()
 
 
 
+
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::cleanupMarkedConnections()
+// Init of Database::Pool::healthCheckLoop()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::cleanupMarkedConnections()
+void Database::Pool::healthCheckLoop()
 {
-  static constexpr const char* fName = "Database::Pool::cleanupMarkedConnections";
-
-  Database::Pool::PoolData& pool = this->getPoolData();
+  static constexpr const char* fName = "Database::Pool::healthCheckLoop";
 
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+  std::size_t cursor = 0;                                                                           // Round-robin position in shards
 
-  for (auto it : pool.connectionsToRemove)
+  while (running.load(std::memory_order_acquire))
   {
-    try
+    spdlog::trace("Running {}", fName);
+
+    Database::Pool::PoolData& pool = this->getPoolData();
+
+    this->autoscale();                                                                              // Also keeps DBPOOLSIZEMIN
+
+    this->healthCheckNext(cursor);
+
+    if (pool.breaker.state.load(std::memory_order_acquire) == Breaker::State::Open)
     {
-      if (it != pool.connections.end())
-      {
-        auto& [connection, metrics] = *it;
-        connection->close();
-        spdlog::debug("[{}] Removed connection (used {} times)", fName, metrics.usage_count);
-        pool.connections.erase(it);
-      }
+      std::lock_guard<std::mutex> lock(pool.connections_mutex);
+      this->probeBreaker();                                                                         // Recovers even with no traffic
+    }
+
+    if (this->getThreadAffinity().count() > 0                                                       // Threads gone quiet
+        && this->reclaimParked(this->getThreadAffinity(), pool.slots.size()) > 0
+        && pool.waiting.load() > 0)
+    {
+      std::lock_guard<std::mutex> lock(pool.connections_mutex);
+      this->handOff();
     }
-    catch (const std::exception& e)
+
+    condition.notify_all();
+
+    // One connection per tick: a full round over the pool takes about one DBHEALTHCHECKINTERVAL.
+    // Shards are visited in turn and each owns slots.size() / shards of them, so this holds per shard
+    const auto ticks = static_cast<std::chrono::milliseconds::rep>(std::max<std::size_t>(pool.slots.size(), 1));
+    const auto tick  = std::max(std::chrono::milliseconds(1), this->getHealthCheckInterval() / ticks);
+
     {
-      spdlog::error("[{}] Error removing connection: {}", fName, e.what());
+      std::unique_lock<std::mutex> waitlock(this->shutdown_mutex_);
+      shutdown_cv_.wait_for(
+            waitlock,
+            tick,
+            []{
+                return !running.load(std::memory_order_acquire);
+            }
+      );
     }
   }
-
-  pool.connectionsToRemove.clear();
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::cleanupMarkedConnections()
+// End of Database::Pool::healthCheckLoop()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -1060,87 +1397,96 @@ void Database::Pool::cleanupMarkedConnections()
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::cleanupIdleConnections()
+// Init of Database::Pool::healthCheckNext()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// void Database::Pool::cleanupIdleConnections()
-// {
-//   std::lock_guard<std::mutex> lock(Database::Pool::connections_mutex);
-//   auto now = std::chrono::steady_clock::now();
-
-//   for (auto it = Database::Pool::connections.begin(); it != Database::Pool::connections.end(); )
-//   {
-//     if (Database::Pool::connections.size()<=Database::Pool::getPoolSizeMin())
-//     {
-//       break;
-//     }
-//     const auto& [connection, metrics] = *it;
-
-//     // Convert weak_ptr into a shared_ptr
-
-//     // auto idle_time = std::chrono::duration_cast<std::chrono::milliseconds>(now - metrics.end_time);
-
-//     // std::cout << (metrics.is_acquired.load(std::memory_order_acquire) ? "ACQUIRED" : "IDLE")
-//     //           << " - Idle time: " << idle_time.count() << "ms"
-//     //           << " - Timeout: " << Database::Pool::getPoolTimeout().count() << "ms\n";
-
-//     // Se la connessione non è in uso ed è inattiva da troppo tempo
-//     if (!metrics.is_acquired && ((now - metrics.end_time) > Database::Pool::getPoolTimeout()))
-//     {
-//       // Log delle metriche prima di rimuovere
-//       auto total_usage_ms = std::chrono::duration_cast<std::chrono::milliseconds>(metrics.total_duration);
-//       std::cout << "Closing connection - Total usage: "
-//                 << total_usage_ms.count() << "ms, "
-//                 << "Used " << metrics.usage_count << " times\n";
-
-//       // USA LO shared_ptr OTTENUTO DAL LOCK
-//       Database::Pool::closeConnection(connection);
-//     }
-//     else
-//     {
-//       ++it;
-//     }
-//   }
-// }
-// -------------------------------------------------------------------------------------------------
-// End of Database::Pool::cleanupIdleConnections()
-// -------------------------------------------------------------------------------------------------
-// -------------------------------------------------------------------------------------------------
+// Checks out the next idle connection of one shard like a normal client, validates it without
+// holding any lock and gives it back. Connections released within the last interval already proved
+// alive. Successive calls walk the shards round-robin.
+void Database::Pool::healthCheckNext(std::size_t& cursor)
+{
+  static constexpr const char* fName = "Database::Pool::healthCheckNext";
 
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  Shard& shard = pool.shards[cursor++ % pool.shards.size()];
 
+  std::unique_lock<std::mutex> lock(shard.mutex);
 
+  const auto now = std::chrono::steady_clock::now();
 
+  // The bottom of the idle stack holds the least recently released connections
+  auto due = std::find_if(shard.idle.begin(), shard.idle.end(), [&](std::size_t index) {
+    const auto& metrics = pool.slots[index].metrics;
+    return (now - std::max(metrics.end_time, metrics.last_checked)) >= this->getHealthCheckInterval();
+  });
 
+  if (due == shard.idle.end())
+  {
+    return;
+  }
 
+  const std::size_t index = *due;
+  shard.idle.erase(due);
 
+  auto& [connection, metrics, generation] = pool.slots[index];
+  metrics.is_acquired = true;                                                                       // Don't let threads acquire this connection while validating
 
+  lock.unlock();
 
+  bool       valid   = false;
+  const auto started = std::chrono::steady_clock::now();
 
-// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::acquire()
-// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-std::optional<Database::ConnectionWrapper> Database::Pool::acquire()
-{
   try
   {
-    auto connection_opt = this->acquireConnection();
+    valid = this->validateConnection(connection);
+  }
+  catch(...)
+  {
+    valid = false;
+  }
 
-    if (connection_opt) {
-        return ConnectionWrapper(
-            connection_opt,
-            [this](dboptuniqptr conn_ptr){
-              this->releaseConnection(conn_ptr);
-            });
-    }
+  pool.validateTime.record(std::chrono::steady_clock::now() - started);
+
+  if (!valid)
+  {
+    pool.validationErrors.increment();
   }
-  catch (const repository::broken_connection& e)
+  else
   {
-    throw;
+    this->countSuccess();
   }
 
-  return std::nullopt;
+  lock.lock();
+
+  if (!valid)
+  {
+    spdlog::info("[{}] Invalid connection removed", fName);
+
+    dbuniq dead = this->removeConnection(index);
+
+    lock.unlock();
+
+    this->settleBroken(dead);
+
+    return;
+  }
+
+  spdlog::trace("[{}] Connection is valid", fName);
+
+  metrics.is_acquired  = false;
+  metrics.last_checked = std::chrono::steady_clock::now();
+  shard.idle.push_back(index);
+
+  lock.unlock();
+
+  if (pool.waiting.load() > 0)                                                                      // Parked while it was checked out
+  {
+    std::lock_guard<std::mutex> poolLock(pool.connections_mutex);
+    this->handOff();
+  }
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::acquire()
+// End of Database::Pool::healthCheckNext()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -1154,40 +1500,44 @@ std::optional<Database::ConnectionWrapper> Database::Pool::acquire()
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::releaseConnection()
+// Init of Database::Pool::calculateAverageDuration()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::releaseConnection(dboptuniqptr connection_opt)
+std::chrono::milliseconds Database::Pool::calculateAverageDuration()
 {
-  if (connection_opt.has_value())
-  {
-    const dbuniq* unique_ptr_ptr = connection_opt.value();
+  std::chrono::milliseconds total_duration{0};
+  int total_operations = 0;
 
+  {
     Database::Pool::PoolData& pool = this->getPoolData();
 
-    std::unique_lock lock(pool.connections_mutex, std::try_to_lock);
+    const std::size_t shards = pool.shards.size();
 
-    for (auto it = pool.connections.begin(); it != pool.connections.end(); ++it)
+    for (std::size_t s = 0; s < shards; ++s)
     {
-      if (&it->first == unique_ptr_ptr)
-      {
-        auto& metrics = it->second;
-        auto now = std::chrono::steady_clock::now();
-        metrics.end_time = now;
-        metrics.last_duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - metrics.start_time);
-        metrics.total_duration += metrics.last_duration;
-        metrics.is_acquired = false;
+      std::lock_guard<std::mutex> lock(pool.shards[s].mutex);
 
-        Database::Pool::condition.notify_one();
+      for (std::size_t index = s; index < pool.slots.size(); index += shards)
+      {
+        const auto& [connection, metrics, generation] = pool.slots[index];
 
-        return;
+        if (connection)
+        {
+          total_duration += metrics.total_duration;
+          total_operations += metrics.usage_count;
+        }
       }
     }
+  }
 
-    spdlog::warn("Connection not found in pool during release");
+  if (total_operations == 0)
+  {
+    return std::chrono::milliseconds(0);
   }
+
+  return std::chrono::milliseconds(total_duration / total_operations);
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::releaseConnection()
+// End of Database::Pool::calculateAverageDuration()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -1201,25 +1551,1476 @@ void Database::Pool::releaseConnection(dboptuniqptr connection_opt)
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::getTotalDuration()
+// Init of Database::Pool::acquireConnection()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-const std::chrono::milliseconds Database::Pool::getTotalDuration(const dbuniq& connection)
+std::optional<Database::ConnectionHandle> Database::Pool::acquireConnection(std::chrono::steady_clock::time_point deadline)
 {
-  Database::Pool::PoolData& pool = this->getPoolData();
-
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+  static constexpr const char* fName = "Database::Pool::acquireConnection";
 
-  if (auto it = pool.connections.find(connection); it != pool.connections.end())
+  if (!running.load(std::memory_order_acquire))
   {
-    return it->second.total_duration;
+    return std::nullopt;
   }
 
-  return std::chrono::milliseconds(0);
-}
-// -------------------------------------------------------------------------------------------------
-// End of Database::Pool::getTotalDuration()
-// -------------------------------------------------------------------------------------------------
-// -------------------------------------------------------------------------------------------------
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  if (const Breaker::State state = pool.breaker.state.load(std::memory_order_acquire); state != Breaker::State::Closed)
+  {
+    if (state == Breaker::State::Open                                                               // Due for a probe
+        && std::chrono::steady_clock::now().time_since_epoch().count() >= pool.breaker.retry_at.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(pool.connections_mutex);
+      this->probeBreaker();
+    }
+
+    pool.acquireErrors.increment();
+    throw repository::broken_connection("Circuit open: database unavailable");
+  }
+
+  const auto arrived = std::chrono::steady_clock::now();
+
+  if (this->getThreadAffinity().count() > 0)
+  {
+    if (std::optional<ConnectionHandle> handle = this->reuseAffine(); handle.has_value())
+    {
+      pool.waitTime.record(std::chrono::steady_clock::now() - arrived);
+      return handle;                                                                                // Hot thread, no lock taken
+    }
+  }
+
+  std::optional<ConnectionHandle> handle;
+  bool                            timedOut = false;
+
+  if (pool.waiting.load() == 0)                                                                     // Don't overtake parked requests
+  {
+    handle = this->checkOut(this->homeShard(), false);                                              // Home shard, then steal
+  }
+
+  if (!handle.has_value())
+  {
+    std::unique_lock<std::mutex> lock(pool.connections_mutex);
+
+    // Queue first, then look again: a release that raced with the fast path above either left
+    // its slot for handOff() to find, or saw this waiter and will hand the slot over itself
+    Waiter waiter;
+    pool.waiters.push_back(&waiter);
+    pool.waiting++;
+
+    this->handOff();
+
+    if (!waiter.handle.has_value() && this->getThreadAffinity().count() > 0
+        && this->reclaimParked(std::chrono::milliseconds(0), pool.waiters.size()) > 0)
+    {
+      this->handOff();                                                                              // Starving: take cached connections back
+    }
+
+    if (!waiter.handle.has_value()
+        && pool.size() + pool.pending + pool.opening < this->getPoolSizeMax()
+        && pool.pending + pool.opening < pool.waiters.size())
+    {
+      // No idle connection! Do not await healthCheckLoop(). Ask the factory for one and wait for it
+      this->init(1);
+    }
+
+    if (!waiter.handle.has_value()
+        && (pool.size() > 0 || pool.pending > 0 || pool.opening > 0))                              // Something to wait for
+    {
+      // Pool exhausted: queue behind earlier requests until a slot is handed over or DBMAXWAIT expires
+      timedOut = !waiter.cv.wait_until(
+        lock,
+        deadline,
+        [&waiter]{
+          return waiter.handle.has_value() || waiter.failed || !running.load(std::memory_order_acquire);
+        }
+      );
+    }
+
+    if (waiter.failed)
+    {
+      pool.acquireErrors.increment();
+      throw repository::broken_connection("Server unreachable or port closed");
+    }
+
+    if (!waiter.handle.has_value())
+    {
+      pool.waiters.erase(std::find(pool.waiters.begin(), pool.waiters.end(), &waiter));
+      pool.waiting--;
+    }
+
+    handle = waiter.handle;
+  }
+
+  if (handle.has_value())
+  {
+    const std::size_t index      = handle->slot                                               ;
+    const dbuniq&     connection = *handle->connection.value()                                ;
+
+    pool.waitTime.record(std::chrono::steady_clock::now() - arrived);
+
+    try                                                                                         // The slot is ours, check it unlocked
+    {
+      #if CAOS_VALIDATE_CONNECTION_BEFORE_ACQUIRE==1
+      const auto started = std::chrono::steady_clock::now();
+      const bool valid   = this->validateConnection(connection);
+
+      pool.validateTime.record(std::chrono::steady_clock::now() - started);
+
+      if (valid)
+      {
+      #else
+      if (connection->is_open())
+      {
+      #endif
+        this->countSuccess();
+        return handle                                                                         ;
+      }
+
+      throw repository::broken_connection("Connection lost");
+    }
+    catch (const repository::broken_connection& e)
+    {
+      pool.validationErrors.increment();
+
+      dbuniq dead;
+
+      {
+        // Remove connection
+        Shard& shard = pool.shardOf(index);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        dead = this->removeConnection(index);
+      }
+
+      this->settleBroken(dead);
+
+      throw;
+    }
+  }
+
+  if (timedOut)                                                                                     // Not on shutdown or a tripped breaker
+  {
+    pool.acquireTimeouts.increment();
+  }
+
+  static std::atomic<std::size_t> limiter                                     {0}         ;
+
+  std::size_t current = limiter.fetch_add(1, std::memory_order_acq_rel) + 1               ;
+
+  if (current >= CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED)
+  {
+    std::size_t expected = current;
+
+    if (limiter.compare_exchange_strong(expected, 0,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+    {
+      spdlog::warn("[{}] : Unable to acquire Database connection - {} failed requests (pool busy)", fName, current);
+      spdlog::info("[{}] : Database connection limit exceeded: reduce thread pool size or increase max_connections parameter", fName);
+    }
+  }
+
+  return std::nullopt;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::acquireConnection()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::checkOut()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Pops an idle connection, trying the shard at home first and then every other one in turn, and
+// marks it acquired under the lock of its shard. With wait=false busy shards are skipped rather than
+// queued on: a thread only steals what is free right now.
+std::optional<Database::ConnectionHandle> Database::Pool::checkOut(std::size_t home, bool wait)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const std::size_t shards = pool.shards.size();
+
+  for (std::size_t i = 0; i < shards; ++i)
+  {
+    Shard& shard = pool.shards[(home + i) % shards];
+
+    std::unique_lock<std::mutex> lock(shard.mutex, std::defer_lock);
+
+    if (i == 0 || wait)
+    {
+      lock.lock();
+    }
+    else if (!lock.try_lock())
+    {
+      continue;
+    }
+
+    if (shard.idle.empty())
+    {
+      continue;
+    }
+
+    const std::size_t index = shard.idle.back()                                               ;
+    shard.idle.pop_back()                                                                     ;
+
+    auto& [connection, metrics, generation] = pool.slots[index]                               ;
+
+    auto now = std::chrono::steady_clock::now()                                               ;
+    metrics.start_time    = now                                                               ;
+    metrics.last_acquired = now                                                               ;
+    metrics.is_acquired   = true                                                              ;
+    metrics.usage_count++                                                                     ;
+    shard.arrivals++                                                                          ;
+
+    return ConnectionHandle{&connection, index, generation, &pool.statements[index], &pool.isolation[index], this};
+  }
+
+  return std::nullopt;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::checkOut()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::handleInvalidConnection()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::handleInvalidConnection()
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  std::lock_guard<std::mutex> lock(pool.connections_mutex);
+
+  this->init(1);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::handleInvalidConnection()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::disconnect()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Takes no lock: closes a connection already taken out of the pool by removeConnection(), so a slow
+// or hung server never stalls the threads waiting on a shard or on PoolData::connections_mutex.
+void Database::Pool::disconnect(dbuniq& connection) noexcept
+{
+  static constexpr const char* fName = "Database::Pool::disconnect";
+
+  try
+  {
+    if (connection)
+    {
+      connection->close();
+      spdlog::debug("[{}] Removed connection", fName);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    spdlog::error("[{}] Error removing connection: {}", fName, e.what());
+  }
+
+  connection.reset();
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::disconnect()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::settleBroken()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Takes no lock: disconnects a connection removeConnection() took out because it failed its check
+// or broke while in use, and counts it towards the breaker. When the server drops, the pooled
+// connections fail one after the other long before a dial does: they trip the breaker, not the
+// health check retiring them one per tick. Below the threshold a replacement is queued instead.
+void Database::Pool::settleBroken(dbuniq& connection)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  this->disconnect(connection);
+
+  std::vector<dbuniq> dropped;
+
+  {
+    std::lock_guard<std::mutex> lock(pool.connections_mutex);
+
+    if (this->countFailure())
+    {
+      dropped = this->tripBreaker();
+    }
+    else
+    {
+      this->init(1);                                                                                // Redial
+    }
+  }
+
+  for (dbuniq& idle : dropped)                                                                      // Disconnect off the lock
+  {
+    this->disconnect(idle);
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::settleBroken()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::insertConnection()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold the Shard::mutex owning index, a slot taken with reserveSlot(). The connection
+// goes on the idle stack: handOff() passes it on if someone is waiting.
+void Database::Pool::insertConnection(std::size_t index, dbuniq&& connection)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  auto& slot      = pool.slots[index];
+  slot.connection = std::move(connection);
+  slot.metrics    = ConnectionMetrics{};
+  slot.metrics.end_time = std::chrono::steady_clock::now();                                         // Validated on creation
+  slot.generation++;
+
+  pool.live++;
+  pool.shardOf(index).idle.push_back(index);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::insertConnection()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::removeConnection()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold the Shard::mutex owning index. The connection is handed back, not closed: the
+// caller may let it go out of scope after unlocking, so the disconnect happens off the lock.
+dbuniq Database::Pool::removeConnection(std::size_t index)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  Shard& shard = pool.shardOf(index);
+  auto&  slot  = pool.slots[index];
+
+  if (!slot.connection)
+  {
+    return nullptr;                                                                                 // Already vacant
+  }
+
+  if (!slot.metrics.is_acquired)
+  {
+    auto it = std::find(shard.idle.begin(), shard.idle.end(), index);
+
+    if (it != shard.idle.end())
+    {
+      shard.idle.erase(it);                                                                         // Keep release order
+    }
+  }
+
+  pool.statements[index].clear();                                                                   // Prepared on the outgoing connection
+  pool.isolation[index] = -1;
+
+  dbuniq connection = std::move(slot.connection);
+  slot.metrics = ConnectionMetrics{};
+  slot.generation++;
+
+  pool.affinity[index].state.store(0);                                                              // A thread cache can't take it back
+
+  shard.vacant.push_back(index);
+  pool.live--;
+
+  return connection;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::removeConnection()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::handOff()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. Gives idle slots, from whichever shard has them, to
+// the oldest waiters first and stops when either side runs out.
+void Database::Pool::handOff()
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  while (!pool.waiters.empty())
+  {
+    std::optional<ConnectionHandle> handle = this->checkOut(this->homeShard(), true);
+
+    if (!handle.has_value())
+    {
+      return;
+    }
+
+    Waiter* waiter = pool.waiters.front();
+    pool.waiters.pop_front();
+    pool.waiting--;
+
+    waiter->handle = handle;
+    waiter->cv.notify_one();                                                                        // Under lock: waiter may leave right after
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::handOff()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::failWaiters()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. Wakes every waiter with an error.
+void Database::Pool::failWaiters()
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  for (Waiter* waiter : pool.waiters)
+  {
+    waiter->failed = true;
+    waiter->cv.notify_one();
+  }
+
+  pool.waiters.clear();
+  pool.waiting = 0;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::failWaiters()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::countFailure()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Counts a failed dial, a failed check or a connection broken while in use. True when the breaker
+// should open: DBBREAKERTHRESHOLD failures in a row, or any failure of the half-open probe.
+bool Database::Pool::countFailure() noexcept
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const std::size_t failures = pool.breaker.failures.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+  return failures >= this->getBreakerThreshold()
+         || pool.breaker.state.load(std::memory_order_acquire) == Breaker::State::HalfOpen;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::countFailure()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::countSuccess()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::countSuccess() noexcept
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  if (pool.breaker.failures.load(std::memory_order_relaxed) != 0)                                   // Keep the hot path read-only
+  {
+    pool.breaker.failures.store(0, std::memory_order_relaxed);
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::countSuccess()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::tripBreaker()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. Opens the breaker for DBBREAKERBACKOFFMIN doubled on
+// every trip since it last closed, capped at DBBREAKERBACKOFFMAX. Half of the delay is random ("equal
+// jitter") so pools restarted together don't probe the server in lockstep. Queued requests fail and
+// idle connections are dropped: they are as dead as the ones that just failed. The dropped ones are
+// returned for the caller to disconnect() once it lets go of PoolData::connections_mutex.
+std::vector<dbuniq> Database::Pool::tripBreaker()
+{
+  static constexpr const char* fName = "Database::Pool::tripBreaker";
+
+  Database::Pool::PoolData& pool    = this->getPoolData();
+  Breaker&                  breaker = pool.breaker;
+
+  if (breaker.state.load(std::memory_order_acquire) == Breaker::State::Open)
+  {
+    return {};                                                                                      // Already tripped by another thread
+  }
+
+  breaker.trips++;
+
+  const auto max     = std::chrono::duration_cast<std::chrono::steady_clock::duration>(this->getBreakerBackoffMax());
+  auto       backoff = std::chrono::duration_cast<std::chrono::steady_clock::duration>(this->getBreakerBackoffMin());
+
+  for (std::size_t i = 1; i < breaker.trips && backoff < max; ++i)
+  {
+    backoff *= 2;
+  }
+
+  backoff = std::min(backoff, max);
+
+  const auto half = backoff.count() / 2;
+
+  std::uniform_int_distribution<std::chrono::steady_clock::rep> jitter(0, half);
+
+  const auto delay = std::chrono::steady_clock::duration(backoff.count() - half + jitter(breaker.jitter));
+
+  breaker.retry_at.store((std::chrono::steady_clock::now() + delay).time_since_epoch().count(), std::memory_order_release);
+  breaker.state.store(Breaker::State::Open, std::memory_order_release);
+  pool.breakerTrips.increment();
+
+  pool.pending = 0;
+  this->failWaiters();
+
+  spdlog::warn("[{}] Circuit open after {} failures, next probe in {} ms", fName,
+               breaker.failures.load(), std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
+
+  this->reclaimParked(std::chrono::milliseconds(0), pool.slots.size());
+
+  std::vector<dbuniq> dropped;
+
+  for (Shard& shard : pool.shards)
+  {
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
+
+    while (!shard.idle.empty())
+    {
+      dropped.push_back(this->removeConnection(shard.idle.back()));                                 // Erases it from idle
+    }
+  }
+
+  return dropped;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::tripBreaker()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::probeBreaker()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. Once the backoff has run out, goes half-open and
+// queues a single dial: init() stays closed until the breaker does, so nothing else is dialed.
+void Database::Pool::probeBreaker()
+{
+  static constexpr const char* fName = "Database::Pool::probeBreaker";
+
+  Database::Pool::PoolData& pool    = this->getPoolData();
+  Breaker&                  breaker = pool.breaker;
+
+  if (breaker.state.load(std::memory_order_acquire) != Breaker::State::Open
+      || std::chrono::steady_clock::now().time_since_epoch().count() < breaker.retry_at.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  breaker.state.store(Breaker::State::HalfOpen, std::memory_order_release);
+
+  pool.pending++;
+  this->factory_cv_.notify_one();
+
+  spdlog::info("[{}] Circuit half-open, probing {}:{}", fName, this->getHost(), this->getPort());
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::probeBreaker()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::closeBreaker()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex. A dial went through: back to normal service, and
+// DBPOOLSIZEMIN is queued again if the breaker had been open.
+void Database::Pool::closeBreaker()
+{
+  static constexpr const char* fName = "Database::Pool::closeBreaker";
+
+  Database::Pool::PoolData& pool    = this->getPoolData();
+  Breaker&                  breaker = pool.breaker;
+
+  breaker.failures.store(0, std::memory_order_relaxed);
+
+  if (breaker.state.load(std::memory_order_acquire) == Breaker::State::Closed)
+  {
+    return;
+  }
+
+  breaker.state.store(Breaker::State::Closed, std::memory_order_release);
+  breaker.trips = 0;
+
+  spdlog::info("[{}] Circuit closed, {}:{} is back", fName, this->getHost(), this->getPort());
+
+  this->init();
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::closeBreaker()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::findSlot()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Scans the shards one at a time. On a match the owning shard stays locked in lock, so the slot can
+// be read or removed before anyone else touches it.
+std::optional<std::size_t> Database::Pool::findSlot(const dbconn* connection, std::unique_lock<std::mutex>& lock) noexcept
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  if (connection == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  const std::size_t shards = pool.shards.size();
+
+  for (std::size_t s = 0; s < shards; ++s)
+  {
+    lock = std::unique_lock<std::mutex>(pool.shards[s].mutex);
+
+    for (std::size_t index = s; index < pool.slots.size(); index += shards)
+    {
+      if (pool.slots[index].connection.get() == connection)
+      {
+        return index;
+      }
+    }
+
+    lock.unlock();
+  }
+
+  return std::nullopt;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::findSlot()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::autoscale()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Sizes the pool from observed demand (Little's law: concurrency = arrival rate * mean hold time),
+// growing ahead of it from the maintenance thread and reaping connections idle for DBPOOLTIMEOUT.
+void Database::Pool::autoscale()
+{
+  static constexpr const char* fName = "Database::Pool::autoscale";
+
+  static constexpr auto   window    = std::chrono::milliseconds(100);                               // Minimum sample length
+  static constexpr double alpha     = 0.3;                                                          // EWMA smoothing factor
+  static constexpr double headroom  = 1.25;                                                         // Spare capacity over demand
+
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  std::unique_lock<std::mutex> lock(pool.connections_mutex);
+
+  Demand&    demand  = pool.demand;
+  const auto now     = std::chrono::steady_clock::now();
+  const auto elapsed = now - demand.sampled_at;
+
+  if (elapsed >= window)
+  {
+    std::size_t               arrivals = 0;
+    std::size_t               releases = 0;
+    std::size_t               idle     = 0;
+    std::chrono::microseconds held {0};
+
+    for (Shard& shard : pool.shards)                                                                // Collect and restart the counters
+    {
+      std::lock_guard<std::mutex> shardLock(shard.mutex);
+
+      arrivals += std::exchange(shard.arrivals, 0);
+      releases += std::exchange(shard.releases, 0);
+      held     += std::exchange(shard.held, std::chrono::microseconds(0));
+      idle     += shard.idle.size();
+    }
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double lambda  = static_cast<double>(arrivals) / seconds;
+
+    if (releases > 0)
+    {
+      const double hold = std::chrono::duration<double>(held).count() / static_cast<double>(releases);
+      demand.hold_ewma = alpha * hold + (1.0 - alpha) * demand.hold_ewma;
+    }
+
+    const double inUse       = static_cast<double>(pool.size() - std::min(idle, pool.size()));
+    const double concurrency = std::max(lambda * demand.hold_ewma, inUse);
+
+    demand.concurrency_ewma = alpha * concurrency + (1.0 - alpha) * demand.concurrency_ewma;
+    demand.sampled_at       = now;
+
+    const std::size_t wanted = static_cast<std::size_t>(std::ceil(demand.concurrency_ewma * headroom)) + pool.waiters.size();
+    const std::size_t target = std::clamp(wanted, this->getPoolSizeMin(), this->getPoolSizeMax());
+
+    if (target != demand.target)
+    {
+      spdlog::debug("[{}] Pool target {} -> {} (lambda {:.1f}/s, hold {:.2f}ms)",
+                    fName, demand.target, target, lambda, demand.hold_ewma * 1000.0);
+      demand.target = target;
+    }
+  }
+
+  const std::size_t target = std::max(demand.target, this->getPoolSizeMin());
+
+  const std::size_t inFlight = pool.size() + pool.pending + pool.opening;
+
+  if (inFlight < target)
+  {
+    this->init(target - inFlight);                                                                  // Grow ahead of demand
+  }
+  else
+  {
+    std::vector<dbuniq> expired = this->cleanupIdleConnections(target);
+
+    lock.unlock();
+
+    for (dbuniq& connection : expired)                                                              // Disconnect off the lock
+    {
+      this->disconnect(connection);
+    }
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::autoscale()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::cleanupIdleConnections()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold PoolData::connections_mutex, shards are locked one at a time. Takes out
+// connections idle longer than DBPOOLTIMEOUT, oldest first within each shard, never going below
+// keep (itself never below DBPOOLSIZEMIN).
+std::vector<dbuniq> Database::Pool::cleanupIdleConnections(std::size_t keep)
+{
+  static constexpr const char* fName = "Database::Pool::cleanupIdleConnections";
+
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  keep = std::max(keep, this->getPoolSizeMin());
+
+  const auto now = std::chrono::steady_clock::now();
+
+  std::vector<dbuniq> expired;
+
+  for (Shard& shard : pool.shards)
+  {
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
+
+    // The bottom of the idle stack holds the least recently released connections
+    for (std::size_t i = 0; i < shard.idle.size() && pool.size() > keep; )
+    {
+      const std::size_t index   = shard.idle[i];
+      const auto&       metrics = pool.slots[index].metrics;
+
+      if ((now - metrics.end_time) <= this->getPoolTimeout())
+      {
+        ++i;
+        continue;
+      }
+
+      spdlog::debug("[{}] Closing idle connection (used {} times, total usage {}ms)",
+                    fName, metrics.usage_count, metrics.total_duration.count());
+
+      expired.push_back(this->removeConnection(index));                                             // Erases idle[i]
+    }
+  }
+
+  return expired;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::cleanupIdleConnections()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::acquire()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::optional<Database::ConnectionWrapper> Database::Pool::acquire(std::chrono::steady_clock::time_point deadline)
+{
+  try
+  {
+    auto handle_opt = this->acquireConnection(deadline);
+
+    if (handle_opt) {
+        this->getPoolData().outstanding.fetch_add(1, std::memory_order_relaxed);
+
+        return ConnectionWrapper(
+            handle_opt.value(),
+            [this](const ConnectionHandle& handle){
+              this->releaseConnection(handle);
+              this->getPoolData().outstanding.fetch_sub(1, std::memory_order_relaxed);
+            });
+    }
+  }
+  catch (const repository::broken_connection& e)
+  {
+    throw;
+  }
+
+  return std::nullopt;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::acquire()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::releaseConnection()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Touches only the shard owning the slot. The pool lock is taken only when requests are parked, to
+// hand them the connection just freed, or when the connection broke while in use: it is counted
+// towards the breaker like a failed check.
+void Database::Pool::releaseConnection(const ConnectionHandle& handle)
+{
+  if (!handle.connection.has_value())
+  {
+    return;
+  }
+
+  if (handle.pool != this)
+  {
+    spdlog::error("Connection handle released to a pool that doesn't own it (slot {})", handle.slot);
+    return;
+  }
+
+  if (this->parkAffine(handle))
+  {
+    return;                                                                                         // Kept by this thread
+  }
+
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  dbuniq dead;
+
+  {
+    Shard& shard = pool.shardOf(handle.slot);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto& [connection, metrics, generation] = pool.slots[handle.slot];
+
+    if (generation != handle.generation || !metrics.is_acquired)
+    {
+      spdlog::debug("Stale connection handle released (slot {})", handle.slot);                     // Closed while in use
+      return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    if (!connection->is_open())                                                                     // Broke while in use, no round trip
+    {
+      dead = this->removeConnection(handle.slot);
+    }
+    else if (Affinity& affinity = pool.affinity[handle.slot]; affinity.state.exchange(0) != 0)
+    {
+      // Reused from a thread cache but released by another thread
+      const auto hold = std::chrono::duration_cast<std::chrono::microseconds>(now - affinity.start);
+
+      pool.holdTime.record(hold);
+
+      affinity.releases++;
+      affinity.held += hold;
+      affinity.last  = hold;
+      affinity.parked_at.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+
+      this->foldAffinity(handle.slot);
+    }
+    else
+    {
+      const auto hold = std::chrono::duration_cast<std::chrono::microseconds>(now - metrics.start_time);
+
+      metrics.end_time = now;
+      metrics.last_duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - metrics.start_time);
+      metrics.total_duration += metrics.last_duration;
+      metrics.is_acquired = false;
+
+      shard.releases++;
+      shard.held += hold;
+
+      pool.holdTime.record(hold);
+
+      shard.idle.push_back(handle.slot);
+    }
+  }
+
+  if (dead)
+  {
+    spdlog::info("Connection broken while in use removed (slot {})", handle.slot);
+    this->settleBroken(dead);
+    return;
+  }
+
+  // Pairs with acquireConnection(): a waiter queues before its last scan of the shards, so either
+  // that scan finds this slot or this load sees the waiter
+  if (pool.waiting.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(pool.connections_mutex);
+    this->handOff();
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::releaseConnection()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::affineHandle()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// The calling thread's cached connection for this pool, keyed by id_ so a thread serving several
+// pools keeps one per pool and never looks into a pool destroyed since.
+std::optional<Database::ConnectionHandle>& Database::Pool::affineHandle() noexcept
+{
+  static constexpr std::size_t maxPools = 8;
+
+  thread_local std::vector<std::pair<std::uint64_t, std::optional<ConnectionHandle>>> cache;
+
+  for (auto& [pool, handle] : cache)
+  {
+    if (pool == this->id_)
+    {
+      return handle;
+    }
+  }
+
+  if (cache.size() >= maxPools)
+  {
+    cache.erase(cache.begin());                                                                     // Oldest pool, likely gone
+  }
+
+  return cache.emplace_back(this->id_, std::nullopt).second;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::affineHandle()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::reuseAffine()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Takes back the connection this thread parked on its last release, with no lock at all. Fails
+// when another thread reclaimed it meanwhile, and then the cache entry is dropped.
+std::optional<Database::ConnectionHandle> Database::Pool::reuseAffine()
+{
+  std::optional<ConnectionHandle>& cached = this->affineHandle();
+
+  if (!cached.has_value())
+  {
+    return std::nullopt;
+  }
+
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const ConnectionHandle handle   = cached.value();
+  Affinity&              affinity = pool.affinity[handle.slot];
+  const std::uint64_t    owner    = (threadNumber() + 1) << 2;
+
+  std::uint64_t expected = owner | Affinity::parked;
+
+  if (!affinity.state.compare_exchange_strong(expected, owner | Affinity::reused, std::memory_order_acq_rel))
+  {
+    cached.reset();
+    return std::nullopt;
+  }
+
+  affinity.start = std::chrono::steady_clock::now();
+
+  if ((*handle.connection.value())->is_open())
+  {
+    return handle;
+  }
+
+  // Dropped while parked: settle the slot like any broken connection
+  cached.reset();
+
+  dbuniq dead;
+
+  {
+    Shard& shard = pool.shardOf(handle.slot);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (pool.slots[handle.slot].generation == handle.generation)
+    {
+      dead = this->removeConnection(handle.slot);
+    }
+  }
+
+  if (dead)
+  {
+    this->settleBroken(dead);
+  }
+
+  throw repository::broken_connection("Connection lost");
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::reuseAffine()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::parkAffine()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Keeps a released connection in the thread cache instead of giving it back to its shard. The
+// first release of a checkout takes the shard lock once to mark the slot parked; releases of a
+// reused connection only flip its state. Returns false when the release must take the normal path:
+// affinity disabled, requests parked, another connection already cached or a stale handle.
+bool Database::Pool::parkAffine(const ConnectionHandle& handle)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  Affinity&           affinity = pool.affinity[handle.slot];
+  const std::uint64_t owner    = (threadNumber() + 1) << 2;
+  const auto          now      = std::chrono::steady_clock::now();
+
+  std::optional<ConnectionHandle>& cached = this->affineHandle();
+
+  if (affinity.state.load(std::memory_order_acquire) == (owner | Affinity::reused))
+  {
+    const auto hold = std::chrono::duration_cast<std::chrono::microseconds>(now - affinity.start);
+
+    pool.holdTime.record(hold);
+
+    affinity.releases++;
+    affinity.held += hold;
+    affinity.last  = hold;
+    affinity.parked_at.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+
+    std::uint64_t expected = owner | Affinity::reused;
+
+    if (pool.waiting.load() == 0
+        && affinity.state.compare_exchange_strong(expected, owner | Affinity::parked))
+    {
+      if (pool.waiting.load() > 0 && this->unpark(handle.slot))                                     // Someone queued meanwhile
+      {
+        std::lock_guard<std::mutex> lock(pool.connections_mutex);
+        this->handOff();
+      }
+
+      return true;
+    }
+
+    cached.reset();
+
+    expected = owner | Affinity::reused;
+
+    if (!affinity.state.compare_exchange_strong(expected, 0, std::memory_order_acq_rel))
+    {
+      return false;                                                                                 // Closed while in use
+    }
+
+    {
+      Shard& shard = pool.shardOf(handle.slot);
+
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      this->foldAffinity(handle.slot);
+    }
+
+    std::lock_guard<std::mutex> lock(pool.connections_mutex);
+    this->handOff();
+
+    return true;
+  }
+
+  if (this->getThreadAffinity().count() == 0 || pool.waiting.load() > 0
+      || affinity.state.load(std::memory_order_acquire) != 0)                                       // Reused by another thread
+  {
+    return false;
+  }
+
+  if (cached.has_value() && cached->slot != handle.slot
+      && (pool.affinity[cached->slot].state.load(std::memory_order_acquire) & ~Affinity::mask) == owner)
+  {
+    return false;                                                                                   // One cached connection per thread
+  }
+
+  {
+    Shard& shard = pool.shardOf(handle.slot);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto& [connection, metrics, generation] = pool.slots[handle.slot];
+
+    if (generation != handle.generation || !metrics.is_acquired)
+    {
+      return false;
+    }
+
+    const auto hold = std::chrono::duration_cast<std::chrono::microseconds>(now - metrics.start_time);
+
+    pool.holdTime.record(hold);
+
+    affinity.generation = generation;
+    affinity.releases   = 1;
+    affinity.held       = hold;
+    affinity.last       = hold;
+    affinity.parked_at.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+    affinity.state.store(owner | Affinity::parked, std::memory_order_seq_cst);
+  }
+
+  cached = handle;
+
+  if (pool.waiting.load() > 0 && this->unpark(handle.slot))                                         // Someone queued meanwhile
+  {
+    std::lock_guard<std::mutex> lock(pool.connections_mutex);
+    this->handOff();
+  }
+
+  return true;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::parkAffine()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::unpark()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Takes a parked connection away from the thread caching it and puts it on its shard's idle stack.
+// Fails if the owner took it back first. Waiters are not served here, see handOff().
+bool Database::Pool::unpark(std::size_t index)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  Affinity& affinity = pool.affinity[index];
+
+  std::uint64_t state = affinity.state.load(std::memory_order_acquire);
+
+  if ((state & Affinity::mask) != Affinity::parked
+      || !affinity.state.compare_exchange_strong(state, 0, std::memory_order_acq_rel))
+  {
+    return false;
+  }
+
+  Shard& shard = pool.shardOf(index);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  return this->foldAffinity(index);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::unpark()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::reclaimParked()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Unparks up to limit connections parked for at least idleFor. Request threads call it with no
+// delay when the pool runs dry; the maintenance thread calls it with DBTHREADAFFINITY to take
+// connections back from threads that went quiet.
+std::size_t Database::Pool::reclaimParked(std::chrono::milliseconds idleFor, std::size_t limit)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+  const auto age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(idleFor).count();
+
+  std::size_t reclaimed = 0;
+
+  for (std::size_t index = 0; index < pool.affinity.size() && reclaimed < limit; ++index)
+  {
+    const Affinity& affinity = pool.affinity[index];
+
+    if ((affinity.state.load() & Affinity::mask) == Affinity::parked
+        && now - affinity.parked_at.load(std::memory_order_relaxed) >= age
+        && this->unpark(index))
+    {
+      reclaimed++;
+    }
+  }
+
+  return reclaimed;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::reclaimParked()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::foldAffinity()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Caller must hold the Shard::mutex owning index and must have set the affinity state to 0. Adds the
+// uses made through the thread cache to the slot metrics and the shard demand counters, then
+// releases the slot to the idle stack. Returns false if the slot was closed in the meantime.
+bool Database::Pool::foldAffinity(std::size_t index)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  Affinity& affinity = pool.affinity[index];
+  Shard&    shard    = pool.shardOf(index);
+
+  auto& [connection, metrics, generation] = pool.slots[index];
+
+  const std::size_t               releases = std::exchange(affinity.releases, 0);
+  const std::chrono::microseconds held     = std::exchange(affinity.held, std::chrono::microseconds(0));
+
+  if (!connection || generation != affinity.generation || !metrics.is_acquired)
+  {
+    return false;
+  }
+
+  const std::chrono::steady_clock::duration parked {affinity.parked_at.load(std::memory_order_relaxed)};
+
+  metrics.end_time        = std::chrono::steady_clock::time_point(parked);
+  metrics.last_duration   = std::chrono::duration_cast<std::chrono::milliseconds>(affinity.last);
+  metrics.total_duration += std::chrono::duration_cast<std::chrono::milliseconds>(held);
+  metrics.usage_count    += static_cast<int>(releases) - 1;                                         // First use counted at checkout
+  metrics.is_acquired     = false;
+
+  shard.arrivals += releases - 1;
+  shard.releases += releases;
+  shard.held     += held;
+
+  shard.idle.push_back(index);
+
+  return true;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::foldAffinity()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::getTotalDuration()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+const std::chrono::milliseconds Database::Pool::getTotalDuration(const dbuniq& connection)
+{
+  Database::Pool::PoolData& pool = this->getPoolData();
+
+  std::unique_lock<std::mutex> lock;
+
+  if (auto index = this->findSlot(connection.get(), lock); index.has_value())
+  {
+    return pool.slots[*index].metrics.total_duration;
+  }
+
+  return std::chrono::milliseconds(0);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::getTotalDuration()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
 
 
 
@@ -1237,11 +3038,11 @@ const std::chrono::milliseconds Database::Pool::getLastDuration(const dbuniq& co
 {
   Database::Pool::PoolData& pool = this->getPoolData();
 
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+  std::unique_lock<std::mutex> lock;
 
-  if (auto it = pool.connections.find(connection); it != pool.connections.end())
+  if (auto index = this->findSlot(connection.get(), lock); index.has_value())
   {
-    return it->second.last_duration;
+    return pool.slots[*index].metrics.last_duration;
   }
 
   return std::chrono::milliseconds(0);
@@ -1267,11 +3068,11 @@ int Database::Pool::getUsageCount(const dbuniq& connection) noexcept
 {
   Database::Pool::PoolData& pool = this->getPoolData();
 
-  std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+  std::unique_lock<std::mutex> lock;
 
-  if (auto it = pool.connections.find(connection); it != pool.connections.end())
+  if (auto index = this->findSlot(connection.get(), lock); index.has_value())
   {
-    return it->second.usage_count;
+    return pool.slots[*index].metrics.usage_count;
   }
 
   return 0;
@@ -1304,22 +3105,34 @@ void Database::Pool::printConnectionStats()
   {
     Database::Pool::PoolData& pool = this->getPoolData();
 
-    std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+    const std::size_t shards = pool.shards.size();
 
-    size = pool.connections.size();
+    size = pool.size();
 
-    for (const auto& [conn, metrics] : pool.connections)
+    for (std::size_t s = 0; s < shards; ++s)
     {
-      total_duration += metrics.total_duration;
-      total_uses += metrics.usage_count;
+      std::lock_guard<std::mutex> lock(pool.shards[s].mutex);
 
-      if (metrics.is_acquired)
-      {
-        active_connections++;
-      }
-      else
+      for (std::size_t index = s; index < pool.slots.size(); index += shards)
       {
-        idle_connections++;
+        const auto& [conn, metrics, generation] = pool.slots[index];
+
+        if (!conn)
+        {
+          continue;
+        }
+
+        total_duration += metrics.total_duration;
+        total_uses += metrics.usage_count;
+
+        if (metrics.is_acquired)
+        {
+          active_connections++;
+        }
+        else
+        {
+          idle_connections++;
+        }
       }
     }
   }
@@ -1378,6 +3191,39 @@ Database::Database()
   // Run Pool
   this->pool = std::make_unique<Pool>();
 
+  for (const Endpoint& replica : this->pool->getReplicas())
+  {
+    this->replicas.push_back(std::make_unique<Pool>(replica));
+  }
+
+  // Bulkheads: the connections reserved in queries.yaml are kept apart from the shared permits
+  #if QUERY_RESERVED_CONNECTIONS > 0
+  if (QUERY_RESERVED_CONNECTIONS >= this->pool->getPoolSizeMax())
+  {
+    throw std::out_of_range("Connections reserved in queries.yaml >= DBPOOLSIZEMAX");
+  }
+
+  this->bulkheadShared = this->pool->getPoolSizeMax() - QUERY_RESERVED_CONNECTIONS;
+  #endif
+
+  this->bulkheadWait = this->pool->getMaxWait();
+
+  // Async engine: its own connections to the primary, apart from the pool
+  #ifdef CAOS_USE_DB_POSTGRESQL
+  if (this->pool->getAsyncConnections() > 0)
+  {
+    this->async = std::make_unique<AsyncEngine>(
+      this->pool->getConnectStr(),
+      this->pool->getAsyncConnections(),
+      this->pool->getAsyncQueue(),
+      std::chrono::seconds(this->pool->getConnectTimeout()),
+      this->pool->getMaxWait(),
+      this->pool->getBreakerBackoffMin(),
+      this->pool->getBreakerBackoffMax()
+    );
+  }
+  #endif
+
   spdlog::info("Database init ok");
 }
 
@@ -1385,11 +3231,336 @@ Database::~Database()
 {
   spdlog::trace("Destroying Database");
 
+  #ifdef CAOS_USE_DB_POSTGRESQL
+  this->async.reset();                                                                              // Fails what it still holds
+  #endif
+
+  this->replicas.clear();
   this->pool.reset();
   this->database.reset();
 
   spdlog::info("Database destroyed");
 }
 
-std::optional<Database::ConnectionWrapper>  Database::acquire()                                 { return this->pool->acquire();               }
-void                                        Database::releaseConnection(dboptuniqptr connection){ this->pool->releaseConnection(connection);  }
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::RouteScope
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+Database::RouteScope::RouteScope(Access access) noexcept
+  : previous(Database::route())
+{
+  Database::route() = access;
+}
+
+
+
+Database::RouteScope::~RouteScope()
+{
+  Database::route() = this->previous;
+}
+
+
+
+// Access of the query running on the calling thread, Write outside any RouteScope
+Database::Access& Database::route() noexcept
+{
+  thread_local Access access = Access::Write;
+
+  return access;
+}
+
+
+
+// Deadline left by the BulkheadScope of the query running on the calling thread for its next
+// acquire(), empty outside any BulkheadScope or once acquire() took it
+std::optional<std::chrono::steady_clock::time_point>& Database::deadline() noexcept
+{
+  thread_local std::optional<std::chrono::steady_clock::time_point> until;
+
+  return until;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::RouteScope
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Bulkhead
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+Database::Bulkhead::Bulkhead(const char* name, std::size_t maxConcurrency, std::size_t reserved) noexcept
+  : name(name),
+    maxConcurrency(maxConcurrency),
+    reserved(reserved)
+{
+}
+
+
+
+Database::BulkheadScope::BulkheadScope(Database& database, Bulkhead& bulkhead)
+  : database(database),
+    bulkhead(bulkhead),
+    previous(Database::deadline())
+{
+  const auto deadline = std::chrono::steady_clock::now() + database.bulkheadWait;
+
+  Database::deadline() = deadline;                                                                  // acquire() waits the rest only
+
+  {
+    std::unique_lock<std::mutex> lock(bulkhead.mutex);
+
+    if (bulkhead.maxConcurrency > 0
+        && !bulkhead.cv.wait_until(lock, deadline, [&bulkhead]{
+             return bulkhead.active < bulkhead.maxConcurrency;
+           }))
+    {
+      Database::deadline() = this->previous;
+
+      throw repository::broken_connection(
+        fmt::format("{} is already running {} times (max_concurrency)", bulkhead.name, bulkhead.maxConcurrency));
+    }
+
+    bulkhead.active++;
+
+    if (bulkhead.reservedActive < bulkhead.reserved)                                                // Own share, always there
+    {
+      bulkhead.reservedActive++;
+      this->reserved = true;
+      return;
+    }
+  }
+
+  if (database.bulkheadShared == 0)                                                                 // No query reserves anything
+  {
+    return;
+  }
+
+  if (!database.replicas.empty() && Database::route() == Access::Read)                              // Replica connection, not the primary's
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(database.bulkheadMutex);
+
+  if (!database.bulkheadCv.wait_until(lock, deadline, [&database]{
+        return database.bulkheadActive < database.bulkheadShared;
+      }))
+  {
+    lock.unlock();
+
+    {
+      std::lock_guard<std::mutex> bulkheadLock(bulkhead.mutex);
+      bulkhead.active--;
+    }
+
+    bulkhead.cv.notify_one();
+
+    Database::deadline() = this->previous;
+
+    throw repository::broken_connection(
+      fmt::format("{}: every unreserved connection is busy", bulkhead.name));
+  }
+
+  database.bulkheadActive++;
+  this->shared = true;
+}
+
+
+
+Database::BulkheadScope::~BulkheadScope()
+{
+  Database::deadline() = this->previous;
+
+  if (this->shared)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->database.bulkheadMutex);
+      this->database.bulkheadActive--;
+    }
+
+    this->database.bulkheadCv.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->bulkhead.mutex);
+
+    this->bulkhead.active--;
+
+    if (this->reserved)
+    {
+      this->bulkhead.reservedActive--;
+    }
+  }
+
+  this->bulkhead.cv.notify_one();
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Bulkhead
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::pickReplica()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Least outstanding requests among the replicas accepting connections, nullptr if none is. The
+// scan starts one replica further at every call, so ties (an idle cluster above all) are spread
+// round-robin
+Database::Pool* Database::pickReplica() noexcept
+{
+  const std::size_t count = this->replicas.size();
+  const std::size_t start = this->nextReplica.fetch_add(1, std::memory_order_relaxed) % count;
+
+  Pool*       best     = nullptr;
+  std::size_t bestLoad = 0;
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Pool* candidate = this->replicas[(start + i) % count].get();
+
+    if (!candidate->isReachable())
+    {
+      continue;
+    }
+
+    const std::size_t load = candidate->getOutstanding();
+
+    if (best == nullptr || load < bestLoad)
+    {
+      best     = candidate;
+      bestLoad = load;
+    }
+
+    if (bestLoad == 0)
+    {
+      break;
+    }
+  }
+
+  return best;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::pickReplica()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::acquire()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Reads go to a replica when there is one. A replica that is down or exhausted doesn't fail the
+// query: it falls back to the primary, which always takes writes and untagged queries. Both waits
+// share one DBMAXWAIT deadline, a read never waits longer than a write. Under a BulkheadScope the
+// deadline is the one the permit started, so waiting for the permit and for the connection add up
+// to DBMAXWAIT too
+std::optional<Database::ConnectionWrapper> Database::acquire()
+{
+  static constexpr const char* fName = "Database::acquire";
+
+  const auto deadline = std::exchange(Database::deadline(), std::nullopt)
+                          .value_or(std::chrono::steady_clock::now() + this->pool->getMaxWait());
+
+  if (!this->replicas.empty() && Database::route() == Access::Read)
+  {
+    try
+    {
+      if (Pool* replica = this->pickReplica(); replica != nullptr)
+      {
+        if (std::optional<ConnectionWrapper> connection = replica->acquire(deadline); connection.has_value())
+        {
+          return connection;
+        }
+      }
+    }
+    catch (const repository::broken_connection& e)
+    {
+      spdlog::debug("[{}] Replica unavailable, reading from primary: {}", fName, e.what());
+    }
+  }
+
+  return this->pool->acquire(deadline);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::acquire()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::getReplicaMetrics()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// One entry per replica pool, in the order of Pool::getReplicas(): reads are served there, so their
+// load and saturation don't show in getMetrics()
+std::vector<Database::Pool::Metrics> Database::getReplicaMetrics()
+{
+  std::vector<Pool::Metrics> metrics;
+  metrics.reserve(this->replicas.size());
+
+  for (const std::unique_ptr<Pool>& replica : this->replicas)
+  {
+    metrics.push_back(replica->getMetrics());
+  }
+
+  return metrics;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::getReplicaMetrics()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+void                                        Database::releaseConnection(const ConnectionHandle& h)  { if (h.pool) h.pool->releaseConnection(h);   }
+Database::Pool::Metrics                     Database::getMetrics()                              { return this->pool->getMetrics();            }
+std::size_t                                 Database::ingestBatch()                  const noexcept { return this->pool->getIngestBatch();        }
+#ifdef CAOS_USE_DB_POSTGRESQL
+AsyncEngine*                                Database::asyncEngine()                    noexcept { return this->async.get();                   }
+#endif
@@ -3,10 +3,12 @@
 #include <libcaos/config.hpp>
 #include "../IRepository.hpp"
 #include "../Exception.hpp"
+#include "Telemetry.hpp"
 
 #ifdef CAOS_USE_DB_POSTGRESQL
 #include <pqxx/pqxx>
 #include <pqxx/except>
+#include "PostgreSQL/AsyncEngine.hpp"
 #endif
 
 #ifdef CAOS_USE_DB_MYSQL
@@ -45,9 +47,16 @@ struct fmt::formatter<sql::SQLString> : formatter<std::string>
 #endif
 
 #include <mutex>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <optional>
 #include <memory>
+#include <vector>
+#include <utility>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 enum class DatabaseType: std::uint8_t {
   PostgreSQL  = 0,
@@ -60,6 +69,7 @@ enum class DatabaseType: std::uint8_t {
 using dbconn            = pqxx::connection;
 using dbuniq            = std::unique_ptr<pqxx::connection>;
 using dboptuniqptr      = std::optional<const std::unique_ptr<pqxx::connection>*>;
+using dbstatements      = std::unordered_set<std::string>;                                          // Names prepared on the server
 using broken_connection = pqxx::broken_connection;
 using sql_exception     = pqxx::sql_error;
 
@@ -68,6 +78,7 @@ using sql_exception     = pqxx::sql_error;
 using dbconn            = sql::Connection;
 using dbuniq            = std::unique_ptr<sql::Connection>;
 using dboptuniqptr      = std::optional<const std::unique_ptr<sql::Connection>*>;
+using dbstatements      = std::unordered_map<std::string, std::unique_ptr<sql::PreparedStatement>>;
 using broken_connection = sql::SQLException;
 using sql_exception     = sql::SQLException;
 
@@ -75,6 +86,7 @@ using sql_exception     = sql::SQLException;
 using dbconn            = sql::Connection;
 using dbuniq            = std::unique_ptr<sql::Connection>;
 using dboptuniqptr      = std::optional<const std::unique_ptr<sql::Connection>*>;
+using dbstatements      = std::unordered_map<std::string, std::unique_ptr<sql::PreparedStatement>>;
 using broken_connection = sql::SQLException;
 using sql_exception     = sql::SQLException;
 
@@ -85,12 +97,98 @@ using sql_exception     = sql::SQLException;
 class Database : public IRepository
 {
   public:
+    using Endpoint = std::pair<std::string, std::uint16_t>;                                         // Host, port
+
+    // Where a query may run, from its access attribute in queries.yaml: reads go to a replica
+    // when DBREPLICAS lists any, everything else to the primary
+    enum class Access
+    {
+      Read,
+      Write
+    };
+
+    // Tags the queries this thread runs while in scope, restoring the previous tag on exit. The
+    // generated QUERY_FORWARDING_DATABASE() methods open one around each query with access: read
+    class RouteScope
+    {
+      public:
+        explicit RouteScope(Access access) noexcept;
+        ~RouteScope();
+
+        RouteScope(const RouteScope&) = delete;
+        RouteScope& operator=(const RouteScope&) = delete;
+
+      private:
+        Access                                        previous                                  ;
+    };
+
+    // Concurrency limits of one query, from max_concurrency and reserved in queries.yaml. The
+    // generated QUERY_FORWARDING_DATABASE() methods keep one as a static and hold a BulkheadScope
+    // around the call, so a capped query waits on its own bulkhead instead of draining the pool
+    class BulkheadScope;
+
+    class Bulkhead
+    {
+      public:
+        Bulkhead(const char* name, std::size_t maxConcurrency, std::size_t reserved) noexcept;
+
+        Bulkhead(const Bulkhead&) = delete;
+        Bulkhead& operator=(const Bulkhead&) = delete;
+
+      private:
+        friend class BulkheadScope;
+
+        const char*                                   name                                      ;
+        const std::size_t                             maxConcurrency                            ;     // 0: no cap
+        const std::size_t                             reserved                                  ;     // Connections no other query may take
+        std::size_t                                   active                {0}                 ;
+        std::size_t                                   reservedActive        {0}                 ;
+        std::mutex                                    mutex                                     ;
+        std::condition_variable                       cv                                        ;
+    };
+
+    // Permit to run one call of a query. Past the reserved share of its bulkhead the call also needs
+    // one of the DBPOOLSIZEMAX - QUERY_RESERVED_CONNECTIONS shared permits of the primary, unless
+    // it is a read routed to a replica. Waits up to DBMAXWAIT, then throws broken_connection like an
+    // exhausted pool; the connection the call acquires next gets only what is left of that wait
+    class BulkheadScope
+    {
+      public:
+        BulkheadScope(Database& database, Bulkhead& bulkhead);
+        ~BulkheadScope();
+
+        BulkheadScope(const BulkheadScope&) = delete;
+        BulkheadScope& operator=(const BulkheadScope&) = delete;
+
+      private:
+        Database&                                     database                                  ;
+        Bulkhead&                                     bulkhead                                  ;
+        bool                                          reserved              {false}             ;
+        bool                                          shared                {false}             ;
+        std::optional<std::chrono::steady_clock::time_point> previous                           ;
+    };
+
+    class Pool;
+
+    // Slot index plus the slot generation seen at acquire time: release goes straight to the
+    // slot, and a handle that outlived its connection (closed or replaced) is recognised as stale.
+    // The slot index only means something in the pool it came from, primary or replica
+    struct ConnectionHandle
+    {
+      dboptuniqptr                                    connection                                ;
+      std::size_t                                     slot                  {0}                 ;
+      std::uint64_t                                   generation            {0}                 ;
+      dbstatements*                                   statements            {nullptr}           ;     // Prepared on this connection
+      int*                                            isolation             {nullptr}           ;     // Session level last set on it, -1 = none
+      Pool*                                           pool                  {nullptr}           ;     // Owner, takes it back
+    };
+
     class ConnectionWrapper
     {
       public:
-        ConnectionWrapper(dboptuniqptr conn_ptr,
-                          std::function<void(dboptuniqptr)> release_func)
-          : connection_ptr(conn_ptr),
+        ConnectionWrapper(const ConnectionHandle& handle,
+                          std::function<void(const ConnectionHandle&)> release_func)
+          : handle(handle),
             release_func(std::move(release_func))
         {}
 
@@ -98,18 +196,18 @@ class Database : public IRepository
         {
           if (!released)
           {
-            release_func(connection_ptr);
+            release_func(handle);
           }
         }
 
         // Move constructor
         ConnectionWrapper(ConnectionWrapper&& other) noexcept
-          : connection_ptr(other.connection_ptr),
+          : handle(other.handle),
             release_func(std::move(other.release_func)),
             released(other.released)
         {
           other.released = true;
-          other.connection_ptr = std::nullopt;
+          other.handle.connection = std::nullopt;
         }
 
         // No copy
@@ -120,9 +218,9 @@ class Database : public IRepository
         {
           try
           {
-            if (connection_ptr.has_value())
+            if (handle.connection.has_value())
             {
-              return *(connection_ptr.value()->get());
+              return *(handle.connection.value()->get());
             }
 
             throw repository::broken_connection("Connection wrapper is null");
@@ -135,50 +233,102 @@ class Database : public IRepository
 
         dbconn* operator->() const
         {
-          return connection_ptr.has_value() ? connection_ptr.value()->get() : nullptr;
+          return handle.connection.has_value() ? handle.connection.value()->get() : nullptr;
         }
 
         [[nodiscard]] dbconn* get() const
         {
-          return connection_ptr.has_value() ? connection_ptr.value()->get() : nullptr;
+          return handle.connection.has_value() ? handle.connection.value()->get() : nullptr;
         }
 
         [[nodiscard]] const dbuniq* getRaw() const
         {
-          return connection_ptr.has_value() ? connection_ptr.value() : nullptr;
+          return handle.connection.has_value() ? handle.connection.value() : nullptr;
+        }
+
+        // Server-side prepared statement cached on the pooled connection under name, usually the
+        // query name: sql is only sent, parsed and planned on the first call per connection. The
+        // cache goes away with the connection
+#ifdef CAOS_USE_DB_POSTGRESQL
+        // Call before opening the transaction: tx.exec(statement, params)
+        [[nodiscard]] pqxx::prepped prepared(const std::string& name, const std::string& sql) const
+        {
+          if (handle.statements->count(name) == 0)
+          {
+            (**this).prepare(name, sql);
+            handle.statements->insert(name);
+          }
+
+          return pqxx::prepped{name};
         }
+#elif (defined(CAOS_USE_DB_MYSQL)||defined(CAOS_USE_DB_MARIADB))
+        // Parameters are cleared, the statement is owned by the cache: don't delete it
+        [[nodiscard]] sql::PreparedStatement& prepared(const std::string& name, const std::string& sql) const
+        {
+          std::unique_ptr<sql::PreparedStatement>& statement = (*handle.statements)[name];
+
+          if (!statement)
+          {
+            statement.reset((**this).prepareStatement(sql));
+          }
+
+          statement->clearParameters();
+
+          return *statement;
+        }
+
+        // Isolation level of the transactions this connection starts: SET SESSION only goes to
+        // the server when it differs from the level last set on this connection
+        void isolation(sql::enum_transaction_isolation level) const
+        {
+          if (*handle.isolation != static_cast<int>(level))
+          {
+            (**this).setTransactionIsolation(level);
+            *handle.isolation = static_cast<int>(level);
+          }
+        }
+#endif
 
         void release()
         {
-          if (!released && connection_ptr.has_value())
+          if (!released && handle.connection.has_value())
           {
-            release_func(connection_ptr);
+            release_func(handle);
             released = true;
-            connection_ptr = std::nullopt;
+            handle.connection = std::nullopt;
           }
         }
 
         explicit operator bool() const
         {
-          return connection_ptr.has_value() && !released && connection_ptr.value() != nullptr;
+          return handle.connection.has_value() && !released && handle.connection.value() != nullptr;
+        }
+
+        [[nodiscard]] const ConnectionHandle& getHandle() const
+        {
+          return handle;
         }
 
       private:
-        dboptuniqptr                                  connection_ptr                            ;
-        std::function<void(dboptuniqptr)>             release_func                              ;
+        ConnectionHandle                              handle                                    ;
+        std::function<void(const ConnectionHandle&)>  release_func                              ;
         bool                                          released{false}                           ;
         std::function<void()>                         cleanup_handler_                          ;
     };
 
     class Pool : public Utils
     {
+      friend class Database;                                                                        // Sizes the bulkhead shared permits
+
       private:
         std::condition_variable                       shutdown_cv_                              ;
         std::mutex                                    shutdown_mutex_                           ;
         std::condition_variable                       condition                                 ;
         std::thread                                   healthCheckThread_                        ;
+        std::condition_variable                       factory_cv_                               ;     // Paired with connections_mutex
+        std::vector<std::thread>                      factoryThreads_                           ;
 
-        // Connections map -------------------------------------------------------------------------
+        // Connection slots ------------------------------------------------------------------------
         struct ConnectionMetrics
         {
           std::chrono::steady_clock::time_point       start_time                                ;
@@ -186,49 +336,151 @@ class Database : public IRepository
           std::chrono::milliseconds                   total_duration        {0}                 ;
           std::chrono::milliseconds                   last_duration         {0}                 ;
           std::chrono::steady_clock::time_point       last_acquired                             ;
+          std::chrono::steady_clock::time_point       last_checked                              ;     // Health check, not usage
           int                                         usage_count           {0}                 ;
           bool                                        is_acquired           {false}             ;
 
           ConnectionMetrics() = default;
           ConnectionMetrics(ConnectionMetrics&&) noexcept = default;
           ConnectionMetrics(const ConnectionMetrics&) = delete;
+          ConnectionMetrics& operator=(ConnectionMetrics&&) noexcept = default;
         };
 
-        struct UniquePtrHash
+        // A slot owns one connection. Slots live in a vector sized DBPOOLSIZEMAX once and never
+        // reallocated, so the address of slot.connection is stable for the whole pool lifetime.
+        struct ConnectionSlot
         {
-          std::size_t operator()(const dbuniq& ptr) const
-          {
-            return std::hash<dbconn*>()(ptr.get());
-          }
+          dbuniq                                      connection                                ;
+          ConnectionMetrics                           metrics                                   ;
+          std::uint64_t                               generation            {0}                 ;     // Bumped on insert and remove
         };
 
-        // Equality comparator for unique_ptr<pqxx::connection>
-        struct UniquePtrEqual
+        // Thread affinity of a slot. state packs the owning thread number + 1 (upper bits) with
+        // parked or reused (low bits); 0 means the slot is managed by its shard as usual. The plain
+        // fields belong to whoever holds the slot: its owner while reused or before parking, the
+        // thread that moved state from parked back to 0 afterwards.
+        struct Affinity
         {
-          bool operator()(const dbuniq& ptr1, const dbuniq& ptr2) const
-          {
-            return ptr1.get() == ptr2.get();
-          }
+          static constexpr std::uint64_t              parked                {1}                 ;     // In a thread cache, free to take
+          static constexpr std::uint64_t              reused                {2}                 ;     // Running a query for its owner
+          static constexpr std::uint64_t              mask                  {3}                 ;
+
+          std::atomic<std::uint64_t>                  state                 {0}                 ;
+          std::atomic<std::chrono::steady_clock::rep> parked_at             {0}                 ;
+          std::chrono::steady_clock::time_point       start                                     ;
+          std::uint64_t                               generation            {0}                 ;     // Slot generation when parked
+          std::size_t                                 releases              {0}                 ;     // Not yet folded into metrics
+          std::chrono::microseconds                   held                  {0}                 ;
+          std::chrono::microseconds                   last                  {0}                 ;
         };
 
-        struct PoolData {
-          std::unordered_map<dbuniq,
-                             ConnectionMetrics,
-                             UniquePtrHash,
-                             UniquePtrEqual>          connections;
+        // A request parked on an exhausted pool. Lives on the acquiring thread's stack and is
+        // signalled through its own condition variable once handOff() checks a slot out for it.
+        struct Waiter
+        {
+          std::condition_variable                     cv                                        ;
+          std::optional<ConnectionHandle>             handle                                    ;
+          bool                                        failed                {false}             ;
+        };
 
-          std::vector<decltype(connections)::iterator>connectionsToRemove;
+        // Smoothed demand estimates, updated by autoscale() from the per-shard counters
+        struct Demand
+        {
+          std::chrono::steady_clock::time_point       sampled_at            {std::chrono::steady_clock::now()};
+          double                                      hold_ewma             {0.0}               ;     // Mean hold time, seconds
+          double                                      concurrency_ewma      {0.0}               ;     // Little's law L = lambda * W
+          std::size_t                                 target                {0}                 ;
+        };
+
+        // Circuit breaker over the server. Closed is normal service. DBBREAKERTHRESHOLD failures in a
+        // row open it: acquire() then throws at once, without touching a shard, until retry_at. The
+        // first caller or health tick past retry_at moves it to half-open and queues one probe dial;
+        // success closes it, failure opens it again with a backoff doubled up to DBBREAKERBACKOFFMAX.
+        struct Breaker
+        {
+          enum class State : std::uint8_t { Closed, Open, HalfOpen };
 
+          std::atomic<State>                          state                 {State::Closed}     ;
+          std::atomic<std::chrono::steady_clock::rep> retry_at              {0}                 ;     // Open until then
+          std::atomic<std::size_t>                    failures              {0}                 ;     // In a row, any success resets
+          std::size_t                                 trips                 {0}                 ;     // Since last closed, sets the backoff
+          std::mt19937_64                             jitter                {std::random_device{}()};
+        };
+
+        // A sub-pool with its own lock and free lists. Shard s owns every slot whose index is
+        // congruent to s modulo the shard count; a slot only changes under its owner's lock.
+        struct alignas(64) Shard
+        {
+          std::vector<std::size_t>                    idle;                                     // Stack of idle slot indexes
+          std::vector<std::size_t>                    vacant;                                   // Stack of empty slot indexes
+
+          std::size_t                                 arrivals {0};                             // Demand since the last sample
+          std::size_t                                 releases {0};
+          std::chrono::microseconds                   held     {0};
+
+          std::mutex                                  mutex;
+        };
+
+        struct PoolData {
+          std::vector<ConnectionSlot>                 slots;                                    // Fixed capacity
+          std::vector<Shard>                          shards;                                   // Fixed count
+          std::vector<Affinity>                       affinity;                                 // One per slot
+          std::vector<dbstatements>                   statements;                               // One per slot, owned with its connection
+          std::vector<int>                            isolation;                                // One per slot, see ConnectionHandle
+
+          std::deque<Waiter*>                         waiters;                                  // FIFO, oldest first
+          std::atomic<std::size_t>                    waiting {0};                              // waiters.size(), read unlocked
+
+          std::atomic<std::size_t>                    live {0};                                 // Connected slots, all shards
+          std::atomic<std::size_t>                    outstanding {0};                          // Checked out through acquire()
+          std::size_t                                 pending {0};                              // Queued for the factory
+          std::size_t                                 opening {0};                              // Handshake in progress
+          std::size_t                                 nextShard {0};                            // Where the factory puts the next one
+
+          Demand                                      demand;
+          Breaker                                     breaker;
+
+          // Recorded without any lock, values in microseconds
+          Telemetry::Histogram                        waitTime;                                 // Until acquire() has a connection
+          Telemetry::Histogram                        holdTime;                                 // Acquire to release
+          Telemetry::Histogram                        createTime;                               // openConnection() round-trip
+          Telemetry::Histogram                        validateTime;                             // validateConnection() round-trip
+
+          Telemetry::Counter                          creations;
+          Telemetry::Counter                          creationFailures;
+          Telemetry::Counter                          validationErrors;
+          Telemetry::Counter                          acquireTimeouts;                          // No connection within DBMAXWAIT
+          Telemetry::Counter                          acquireErrors;                            // Server unreachable
+          Telemetry::Counter                          breakerTrips;                             // Closed or half-open to open
+
+          // Guards waiters, pending, opening, demand and breaker transitions. Taken before a shard mutex, never after
           std::mutex                                  connections_mutex;
 
-          PoolData(size_t capacity)
+          PoolData(std::size_t capacity, std::size_t shardCount)
+            : slots(capacity),
+              shards(shardCount),
+              affinity(capacity),
+              statements(capacity),
+              isolation(capacity, -1)
           {
-            connections.reserve(capacity);
-            connectionsToRemove.reserve(capacity);
+            for (std::size_t i = capacity; i > 0; --i)
+            {
+              Shard& shard = this->shardOf(i - 1);
+              shard.vacant.push_back(i - 1);                                                        // Lowest index on top
+            }
+
+            for (Shard& shard : shards)
+            {
+              shard.idle.reserve(shard.vacant.size());
+            }
           }
+
+          [[nodiscard]] std::size_t size() const noexcept { return live.load(std::memory_order_acquire); }
+          [[nodiscard]] Shard& shardOf(std::size_t index) noexcept { return shards[index % shards.size()]; }
         };
 
-        std::atomic<bool>                             connectionRefused     {false}             ;
+        std::unique_ptr<PoolData>                     data_                                     ;
+        std::uint64_t                                 id_                   {0}                 ;     // Unique per Pool, keys thread caches
 
         struct config_s
         {
@@ -244,12 +496,23 @@ class Database : public IRepository
           std::chrono::milliseconds                   maxwait               {CAOS_DBMAXWAIT}    ;
           std::size_t                                 connect_timeout       {CAOS_DBCONNECT_TIMEOUT};
           std::chrono::milliseconds                   healthCheckInterval   {CAOS_DBHEALTHCHECKINTERVAL};
+          std::size_t                                 connect_parallelism   {CAOS_DBCONNECT_PARALLELISM};
+          std::size_t                                 poolshards            {CAOS_DBPOOLSHARDS} ;
+          std::chrono::milliseconds                   threadAffinity        {CAOS_DBTHREADAFFINITY};
+          std::string                                 replicas              {CAOS_DBREPLICAS}   ;
+          std::vector<Endpoint>                       replica_endpoints     {}                  ;     // Parsed from replicas
+          std::size_t                                 breakerThreshold      {CAOS_DBBREAKERTHRESHOLD};
+          std::chrono::milliseconds                   breakerBackoffMin     {CAOS_DBBREAKERBACKOFFMIN};
+          std::chrono::milliseconds                   breakerBackoffMax     {CAOS_DBBREAKERBACKOFFMAX};
+          std::size_t                                 ingestBatch           {CAOS_DBINGESTBATCH};
 
 #ifdef CAOS_USE_DB_POSTGRESQL
           std::size_t                                 keepalives            {CAOS_DBKEEPALIVES} ;
           std::size_t                                 keepalives_idle       {CAOS_DBKEEPALIVES_IDLE};
           std::size_t                                 keepalives_interval   {CAOS_DBKEEPALIVES_INTERVAL};
           std::size_t                                 keepalives_count      {CAOS_DBKEEPALIVES_COUNT};
+          std::size_t                                 async_connections     {CAOS_DBASYNCCONNECTIONS};
+          std::size_t                                 async_queue           {CAOS_DBASYNCQUEUE} ;
           std::string                                 connection_string     {""}                ;
 #elif (defined(CAOS_USE_DB_MYSQL)||defined(CAOS_USE_DB_MARIADB))
           sql::ConnectOptionsMap                      connection_options    {}                  ;
@@ -274,21 +537,66 @@ class Database : public IRepository
         void                                          setKeepAlivesIdle()                       ;
         void                                          setKeepAlivesInterval()                   ;
         void                                          setKeepAlivesCount()                      ;
+        void                                          setAsyncConnections()                     ;
+        void                                          setAsyncQueue()                           ;
         void                                          setConnectStr()                   noexcept;
         #endif
         void                                          setConnectTimeout()                       ;
         void                                          setMaxWait()                              ;
         void                                          setHealthCheckInterval()                  ;
+        void                                          setConnectParallelism()                   ;
+        void                                          setPoolShards()                           ;
+        void                                          setThreadAffinity()                       ;
+        void                                          setReplicas()                             ;
+        void                                          setBreakerThreshold()                     ;
+        void                                          setBreakerBackoffMin()                    ;
+        void                                          setBreakerBackoffMax()                    ;
+        void                                          setIngestBatch()                          ;
 
         #if (defined(CAOS_USE_DB_MYSQL)||defined(CAOS_USE_DB_MARIADB))
         void                                          setConnectOpt()                   noexcept;
         #endif
 
         std::size_t                                   init(std::size_t = 0)                     ;
+        void                                          connectionFactoryLoop()                   ;
         void                                          healthCheckLoop()                         ;
-        dboptuniqptr                                  acquireConnection()                       ;
+        void                                          healthCheckNext(std::size_t&)             ;
+        void                                          autoscale()                               ;
+        std::vector<dbuniq>                           cleanupIdleConnections(std::size_t)       ;
+        std::optional<ConnectionHandle>               acquireConnection(std::chrono::steady_clock::time_point);
+        std::optional<ConnectionHandle>               checkOut(std::size_t, bool)               ;
         void                                          handleInvalidConnection()                 ;
-        void                                          cleanupMarkedConnections()                ;
+        [[nodiscard]] std::size_t                     homeShard()                 const noexcept;
+        [[nodiscard]] static std::size_t              threadNumber()                    noexcept;
+
+        // Thread affinity, see DBTHREADAFFINITY ---------------------------------------------------
+        [[nodiscard]] std::optional<ConnectionHandle>& affineHandle()                   noexcept;
+        std::optional<ConnectionHandle>               reuseAffine()                             ;
+        bool                                          parkAffine(const ConnectionHandle&)       ;
+        bool                                          unpark(std::size_t)                       ;
+        std::size_t                                   reclaimParked(std::chrono::milliseconds, std::size_t);
+        bool                                          foldAffinity(std::size_t)                 ;     // Caller must hold the owning Shard::mutex
+
+        // Slot bookkeeping, caller must hold the owning Shard::mutex ------------------------------
+        void                                          insertConnection(std::size_t, dbuniq&&)   ;
+        dbuniq                                        removeConnection(std::size_t)             ;
+        void                                          disconnect(dbuniq&)               noexcept;     // No lock: takes what removeConnection() returned
+        void                                          settleBroken(dbuniq&)                     ;     // No lock: same, for a connection found dead
+
+        // Pool-wide bookkeeping, caller must hold PoolData::connections_mutex ---------------------
+        [[nodiscard]] std::optional<std::size_t>      reserveSlot()                             ;
+        void                                          handOff()                                 ;
+        void                                          failWaiters()                             ;
+
+        // Circuit breaker, see Breaker. The count functions take no lock and tell whether to trip
+        [[nodiscard]] bool                            countFailure()                    noexcept;
+        void                                          countSuccess()                    noexcept;
+        [[nodiscard]] std::vector<dbuniq>             tripBreaker()                             ;     // Caller must hold PoolData::connections_mutex
+        void                                          probeBreaker()                            ;     // Caller must hold PoolData::connections_mutex
+        void                                          closeBreaker()                            ;     // Caller must hold PoolData::connections_mutex
+
+        // Locks the shard owning the match into the given lock
+        [[nodiscard]] std::optional<std::size_t>      findSlot(const dbconn*, std::unique_lock<std::mutex>&) noexcept;
 
         // Getters ---------------------------------------------------------------------------------
         [[nodiscard]] const std::string&              getUser()                   const noexcept;
@@ -306,6 +614,8 @@ class Database : public IRepository
         [[nodiscard]] const std::size_t&              getKeepAlivesIdle()         const noexcept;
         [[nodiscard]] const std::size_t&              getKeepAlivesInterval()     const noexcept;
         [[nodiscard]] const std::size_t&              getKeepAlivesCount()        const noexcept;
+        [[nodiscard]] const std::size_t&              getAsyncConnections()       const noexcept;
+        [[nodiscard]] const std::size_t&              getAsyncQueue()             const noexcept;
         [[nodiscard]] const std::string&              getConnectStr()             const noexcept;
         #endif
 
@@ -317,10 +627,17 @@ class Database : public IRepository
 
         [[nodiscard]] const std::chrono::milliseconds& getMaxWait()               const noexcept;
         [[nodiscard]] const std::chrono::milliseconds& getHealthCheckInterval()   const noexcept;
+        [[nodiscard]] const std::size_t&              getConnectParallelism()     const noexcept;
+        [[nodiscard]] const std::size_t&              getPoolShards()             const noexcept;
+        [[nodiscard]] const std::chrono::milliseconds& getThreadAffinity()        const noexcept;
+        [[nodiscard]] const std::size_t&              getBreakerThreshold()       const noexcept;
+        [[nodiscard]] const std::chrono::milliseconds& getBreakerBackoffMin()     const noexcept;
+        [[nodiscard]] const std::chrono::milliseconds& getBreakerBackoffMax()     const noexcept;
+        [[nodiscard]] const std::size_t&              getIngestBatch()            const noexcept;
         [[nodiscard]] bool                             checkPoolSize(std::size_t&) noexcept;
 
                       bool                            validateConnection(const dbuniq&)         ;
-                      void                            createConnection(std::size_t&)            ;
+                      dbuniq                          openConnection()                          ;
 
         [[nodiscard]] const std::chrono::milliseconds getTotalDuration(const dbuniq&)           ;
         [[nodiscard]] const std::chrono::milliseconds getLastDuration(const dbuniq&)            ;
@@ -328,8 +645,6 @@ class Database : public IRepository
         [[nodiscard]] int                             getUsageCount(const dbuniq&) noexcept     ;
                       void                            printConnectionStats()                    ;
 
-        // static inline void                              cleanupIdleConnections()          ;
-        // void                                            startCleanupTask()                ;
 
       public:
         void                                          closeConnection(const dbuniq&)            ;
@@ -338,35 +653,70 @@ class Database : public IRepository
         struct Metrics {
           std::size_t                                 available                                 ;
           std::size_t                                 total_known                               ;
-          std::size_t                                 creations                                 ;
-          std::size_t                                 failures                                  ;
-          std::size_t                                 validation_errors                         ;
+          std::uint64_t                               creations                                 ;
+          std::uint64_t                               failures                                  ;
+          std::uint64_t                               validation_errors                         ;
+          std::uint64_t                               acquire_timeouts                          ;
+          std::uint64_t                               acquire_errors                            ;
+          std::uint64_t                               breaker_trips                             ;
+
+          Telemetry::Snapshot                         wait                                      ;     // Microseconds
+          Telemetry::Snapshot                         hold                                      ;
+          Telemetry::Snapshot                         creation                                  ;
+          Telemetry::Snapshot                         validation                                ;
         };
 
-        Pool();
+        explicit Pool(const std::optional<Endpoint>& replica = std::nullopt);                       // Primary unless given a replica
         ~Pool();
 
-        // [[nodiscard]] const Metrics                   getMetrics()                const noexcept;
+        [[nodiscard]] Metrics                         getMetrics()                              ;
+        [[nodiscard]] const std::vector<Endpoint>&    getReplicas()               const noexcept;
+        [[nodiscard]] std::size_t                     getOutstanding()            const noexcept;
+        [[nodiscard]] bool                            isReachable()               const noexcept;     // Breaker closed, no failure since
         [[nodiscard]] std::size_t                     getAvailableConnections()         noexcept;
         [[nodiscard]] std::size_t                     getTotalConnections()             noexcept;
         [[nodiscard]] PoolData&                       getPoolData()                     noexcept;
 
-        std::optional<Database::ConnectionWrapper>    acquire()                                 ;
-        void                                          releaseConnection(dboptuniqptr)           ;
+        std::optional<Database::ConnectionWrapper>    acquire(std::chrono::steady_clock::time_point); // Waits until then at most
+        void                                          releaseConnection(const ConnectionHandle&);
     };
 
   private:
     std::unique_ptr<IRepository>                      database                                  ;
-    std::unique_ptr<Pool>                             pool                                      ;
+    std::unique_ptr<Pool>                             pool                                      ;     // Primary
+    std::vector<std::unique_ptr<Pool>>                replicas                                  ;     // One per DBREPLICAS entry
+    std::atomic<std::size_t>                          nextReplica           {0}                 ;
+
+    // Shared permits of BulkheadScope, the pool share not reserved by any query
+    std::mutex                                        bulkheadMutex                             ;
+    std::condition_variable                           bulkheadCv                                ;
+    std::size_t                                       bulkheadShared        {0}                 ;
+    std::size_t                                       bulkheadActive        {0}                 ;
+    std::chrono::milliseconds                         bulkheadWait          {0}                 ;     // DBMAXWAIT of the primary
     DatabaseType                                      type                                      ;
 
+#ifdef CAOS_USE_DB_POSTGRESQL
+    std::unique_ptr<AsyncEngine>                      async                                     ;     // Off while DBASYNCCONNECTIONS is 0
+#endif
+
+    [[nodiscard]] static Access&                      route()                           noexcept;
+    [[nodiscard]] static std::optional<std::chrono::steady_clock::time_point>& deadline()  noexcept;
+    [[nodiscard]] Pool*                               pickReplica()                     noexcept;
+
   public:
 
     Database();
     ~Database() override;
 
     std::optional<Database::ConnectionWrapper>        acquire()                                 ;
-    void                                              releaseConnection(dboptuniqptr)           ;
+    void                                              releaseConnection(const ConnectionHandle&);
+    [[nodiscard]] Pool::Metrics                       getMetrics()                              ;     // Primary
+    [[nodiscard]] std::vector<Pool::Metrics>          getReplicaMetrics()                       ;     // In DBREPLICAS order
+    [[nodiscard]] std::size_t                         ingestBatch()               const noexcept;     // Rows per statement of a bulk ingest
+
+#ifdef CAOS_USE_DB_POSTGRESQL
+    [[nodiscard]] AsyncEngine*                        asyncEngine()                     noexcept;     // Null while DBASYNCCONNECTIONS is 0
+#endif
 
     QUERY_OVERRIDE() /* <- from "generated_queries/Query_Override.hpp" */
 
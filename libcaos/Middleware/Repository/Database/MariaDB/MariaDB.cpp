@@ -8,6 +8,10 @@
 #include "../../src/include/Database/MariaDB/Query.hpp"
 #endif
 
+#include "generated_queries/Database_Query_Implementation.hpp"
+
+QUERY_IMPLEMENTATION_MARIADB() /* <- from "generated_queries/Database_Query_Implementation.hpp" */
+
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Init of Database::Pool::setConnectStr()
@@ -22,6 +26,9 @@ void Database::Pool::setConnectOpt() noexcept
   options["password"] = this->getPass();
   options["schema"]   = this->getName();
 
+  // executeBatch() sends a bulk ingest as one array-bound COM_STMT_BULK_EXECUTE, not a round trip per row
+  options["useBulkStmts"] = "true";
+
   if (this->getConnectTimeout() > 0)
   {
     options["connectTimeout"] = sql::SQLString(std::to_string(this->getConnectTimeout()));
@@ -149,11 +156,12 @@ bool Database::Pool::validateConnection(const dbuniq& connection)
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::createConnection()
+// Init of Database::Pool::openConnection()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::createConnection(std::size_t& pool_size)
+// Dials and validates a new connection without touching the pool: runs on a factory thread
+dbuniq Database::Pool::openConnection()
 {
-  static constexpr const char* fName = "Database::Pool::createConnection";
+  static constexpr const char* fName = "Database::Pool::openConnection";
 
   static std::atomic<bool> loggedOnce {false};
 
@@ -161,41 +169,23 @@ void Database::Pool::createConnection(std::size_t& pool_size)
   {
     spdlog::debug("[{}] Creating new connection", fName);
 
-    if(!this->checkPoolSize(pool_size))                                                             // Don't saturate MariaDB connections
-    {
-      return;
-    }
-
-    Database::Pool::PoolData& pool = this->getPoolData();
-
     sql::Driver* driver = sql::mariadb::get_driver_instance();
 
     if (!driver)
     {
       spdlog::error("MariaDB driver not available");
-      return;
+      return nullptr;
     }
 
     std::unique_ptr<sql::Connection> connection(driver->connect(this->getConnectOpt()));
 
     if (this->validateConnection(connection))
     {
-      ConnectionMetrics metrics;
-
-      pool.connections.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(std::move(connection)),
-        std::forward_as_tuple(std::move(metrics))
-      );
-
-      spdlog::info("[{}] New valid connection created (total: {})",
-                  fName, this->getTotalConnections());
-
-      this->connectionRefused = false;
+      spdlog::debug("[{}] New valid connection created", fName);
 
       loggedOnce.store(false, std::memory_order_release);
 
-      return;
+      return connection;
     }
 
     connection->close();
@@ -234,10 +224,10 @@ void Database::Pool::createConnection(std::size_t& pool_size)
     }
   }
 
-  return;
+  return nullptr;
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::createConnection()
+// End of Database::Pool::openConnection()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -270,13 +260,13 @@ void Database::Pool::closeConnection(const dbuniq& connection)
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
-      if (auto it = pool.connections.find(connection); it != pool.connections.end())
+      if (auto index = this->findSlot(connection.get(), lock); index.has_value())
       {
         connection->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -324,18 +314,15 @@ void Database::Pool::closeConnection(std::optional<Database::ConnectionWrapper>&
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
       auto* raw = connection.value().get ();
-      auto it = std::find_if (pool.connections.begin(), pool.connections.end(), [raw](auto const& pair) {
-        return pair.first.get() == raw;
-      });
 
-      if (it != pool.connections.end())
+      if (auto index = this->findSlot(raw, lock); index.has_value())
       {
         raw->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -8,6 +8,10 @@
 #include "../../src/include/Database/MySQL/Query.hpp"
 #endif
 
+#include "generated_queries/Database_Query_Implementation.hpp"
+
+QUERY_IMPLEMENTATION_MYSQL() /* <- from "generated_queries/Database_Query_Implementation.hpp" */
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Init of Database::Pool::setConnectStr()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -148,11 +152,12 @@ bool Database::Pool::validateConnection(const dbuniq& connection)
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of Database::Pool::createConnection()
+// Init of Database::Pool::openConnection()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::createConnection(std::size_t& pool_size)
+// Dials and validates a new connection without touching the pool: runs on a factory thread
+dbuniq Database::Pool::openConnection()
 {
-  static constexpr const char* fName = "Database::Pool::createConnection";
+  static constexpr const char* fName = "Database::Pool::openConnection";
 
   static std::atomic<bool> loggedOnce {false};
 
@@ -160,40 +165,22 @@ void Database::Pool::createConnection(std::size_t& pool_size)
   {
     spdlog::debug("[{}] Creating new connection", fName);
 
-    if(!this->checkPoolSize(pool_size))                                                             // Don't saturate MySQL connections
-    {
-      return;
-    }
-
-    Database::Pool::PoolData& pool = this->getPoolData();
-
     sql::mysql::MySQL_Driver* driver = sql::mysql::get_mysql_driver_instance();
     if (!driver)
     {
       spdlog::error("MySQL driver not available");
-      return;
+      return nullptr;
     }
 
     std::unique_ptr<sql::Connection> connection(driver->connect(this->getConnectOpt()));
 
     if (this->validateConnection(connection))
     {
-      ConnectionMetrics metrics;
-
-      pool.connections.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(std::move(connection)),
-        std::forward_as_tuple(std::move(metrics))
-      );
-
-      spdlog::info("[{}] New valid connection created (total: {})",
-                  fName, this->getTotalConnections());
-
-      this->connectionRefused = false;
+      spdlog::debug("[{}] New valid connection created", fName);
 
       loggedOnce.store(false, std::memory_order_release);
 
-      return;
+      return connection;
     }
 
     connection->close();
@@ -232,10 +219,10 @@ void Database::Pool::createConnection(std::size_t& pool_size)
     }
   }
 
-  return;
+  return nullptr;
 }
 // -------------------------------------------------------------------------------------------------
-// End of Database::Pool::createConnection()
+// End of Database::Pool::openConnection()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -268,13 +255,13 @@ void Database::Pool::closeConnection(const dbuniq& connection)
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
-      if (auto it = pool.connections.find(connection); it != pool.connections.end())
+      if (auto index = this->findSlot(connection.get(), lock); index.has_value())
       {
         connection->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -322,18 +309,15 @@ void Database::Pool::closeConnection(std::optional<Database::ConnectionWrapper>&
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
       auto* raw = connection.value().get ();
-      auto it = std::find_if (pool.connections.begin(), pool.connections.end(), [raw](auto const& pair) {
-        return pair.first.get() == raw;
-      });
 
-      if (it != pool.connections.end())
+      if (auto index = this->findSlot(raw, lock); index.has_value())
       {
         raw->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -0,0 +1,804 @@
+#include "AsyncEngine.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <pqxx/except>
+#include <spdlog/spdlog.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace
+{
+  constexpr std::uint64_t wakeupTag = UINT64_MAX;                                                   // epoll data of the eventfd, connections use their index
+  constexpr int           eventsMax = 64;
+
+  // libpq messages end with a newline
+  std::string errorOf(const PGconn* conn)
+  {
+    std::string error = conn ? PQerrorMessage(conn) : "out of memory";
+
+    while (!error.empty() && (error.back() == '\n' || error.back() == ' '))
+    {
+      error.pop_back();
+    }
+
+    return error;
+  }
+
+  bool succeeded(const PGresult* result)
+  {
+    const ExecStatusType status = PQresultStatus(result);
+
+    return status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK || status == PGRES_EMPTY_QUERY;
+  }
+}
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::AsyncEngine()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+AsyncEngine::AsyncEngine(std::string                connectStr,
+                         std::size_t                connections,
+                         std::size_t                queueMax,
+                         std::chrono::seconds       connectTimeout,
+                         std::chrono::milliseconds  maxWait,
+                         std::chrono::milliseconds  backoffMin,
+                         std::chrono::milliseconds  backoffMax)
+  : connectStr(std::move(connectStr)),
+    queueMax(std::max<std::size_t>(queueMax, 1)),
+    connectTimeout(connectTimeout),
+    maxWait(maxWait),
+    backoffMin(backoffMin),
+    backoffMax(std::max(backoffMin, backoffMax)),
+    pool(std::max<std::size_t>(connections, 1))
+{
+  this->epoll  = epoll_create1(EPOLL_CLOEXEC);
+  this->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  epoll_event event{};
+  event.events   = EPOLLIN;
+  event.data.u64 = wakeupTag;
+
+  if (this->epoll < 0 || this->wakeup < 0 || epoll_ctl(this->epoll, EPOLL_CTL_ADD, this->wakeup, &event) < 0)
+  {
+    const std::string error = std::strerror(errno);
+
+    if (this->epoll  >= 0) close(this->epoll);
+    if (this->wakeup >= 0) close(this->wakeup);
+
+    throw repository::broken_connection("Async query engine setup failed: " + error);
+  }
+
+  for (std::size_t index = 0; index < this->pool.size(); ++index)                                  // The loop isn't running yet
+  {
+    this->connect(index);
+  }
+
+  this->loop = std::thread(&AsyncEngine::run, this);
+
+  spdlog::info("Async query engine started with {} connections", this->pool.size());
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::AsyncEngine()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::~AsyncEngine()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+AsyncEngine::~AsyncEngine()
+{
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+
+  const std::uint64_t one = 1;
+  [[maybe_unused]] const ssize_t written = write(this->wakeup, &one, sizeof(one));
+
+  if (this->loop.joinable())
+  {
+    this->loop.join();
+  }
+
+  close(this->epoll);
+  close(this->wakeup);
+
+  spdlog::trace("Async query engine stopped");
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::~AsyncEngine()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::query()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::future<AsyncEngine::Result> AsyncEngine::query(std::string sql, Params params)
+{
+  Request request{std::move(sql), std::move(params), {}, {}, Clock::now() + this->maxWait};
+
+  std::future<Result> future = request.promise.get_future();
+
+  this->enqueue(std::move(request));
+
+  return future;
+}
+
+
+
+void AsyncEngine::query(std::string sql, Params params, Callback done)
+{
+  this->enqueue(Request{std::move(sql), std::move(params), {}, std::move(done), Clock::now() + this->maxWait});
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::query()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::enqueue()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::enqueue(Request&& request)
+{
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    if (this->stopping)
+    {
+      lock.unlock();
+      deliver(request, std::make_exception_ptr(repository::broken_connection("Async query engine stopped")));
+      return;
+    }
+
+    if (this->queue.size() >= this->queueMax)
+    {
+      lock.unlock();
+      deliver(request, std::make_exception_ptr(repository::broken_connection("Async query engine queue full")));
+      return;
+    }
+
+    this->queue.push_back(std::move(request));
+  }
+
+  const std::uint64_t one = 1;
+  [[maybe_unused]] const ssize_t written = write(this->wakeup, &one, sizeof(one));
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::enqueue()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::run()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::run()
+{
+  epoll_event events[eventsMax];
+
+  while (true)
+  {
+    const int count = epoll_wait(this->epoll, events, eventsMax, this->timeout());
+
+    if (count < 0 && errno != EINTR)
+    {
+      spdlog::error("Async query engine stopped, epoll_wait failed: {}", std::strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+      if (events[i].data.u64 == wakeupTag)
+      {
+        std::uint64_t value;
+        [[maybe_unused]] const ssize_t got = read(this->wakeup, &value, sizeof(value));
+        continue;
+      }
+
+      const std::size_t index = static_cast<std::size_t>(events[i].data.u64);
+
+      if (this->pool[index].state == State::Connecting)
+      {
+        this->poll(index);
+        continue;
+      }
+
+      if ((events[i].events & EPOLLOUT) && this->pool[index].state == State::Busy)
+      {
+        this->flush(index);
+      }
+
+      if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+      {
+        this->receive(index);                                                                       // Skips a connection flush just broke
+      }
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->stopping)
+      {
+        break;
+      }
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    for (std::size_t index = 0; index < this->pool.size(); ++index)
+    {
+      if (this->pool[index].retryAt > now)
+      {
+        continue;
+      }
+
+      if (this->pool[index].state == State::Broken)
+      {
+        this->connect(index);
+      }
+      else if (this->pool[index].state == State::Connecting)
+      {
+        this->fail(index, "connect timed out");
+      }
+    }
+
+    this->expire();
+    this->dispatch();
+  }
+
+  // Whatever is left fails, new calls are refused from now on
+  std::deque<Request> left;
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+    left.swap(this->queue);
+  }
+
+  for (Connection& connection : this->pool)
+  {
+    if (connection.running)
+    {
+      left.push_back(std::move(*connection.running));
+      connection.running.reset();
+    }
+
+    PQclear(connection.result);
+    PQfinish(connection.conn);
+
+    connection.result = nullptr;
+    connection.conn   = nullptr;
+    connection.state  = State::Broken;
+  }
+
+  this->ready = 0;
+
+  for (Request& request : left)
+  {
+    deliver(request, std::make_exception_ptr(repository::broken_connection("Async query engine stopped")));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::run()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::timeout()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Milliseconds until the next connection attempt or deadline, -1 when there's none
+int AsyncEngine::timeout()
+{
+  Clock::time_point next = Clock::time_point::max();
+
+  for (const Connection& connection : this->pool)
+  {
+    if (connection.state == State::Broken || connection.state == State::Connecting)
+    {
+      next = std::min(next, connection.retryAt);
+    }
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (!this->queue.empty())
+    {
+      next = std::min(next, this->queue.front().deadline);                                         // Same maxWait for all, the oldest expires first
+    }
+  }
+
+  if (next == Clock::time_point::max())
+  {
+    return -1;
+  }
+
+  const auto wait = std::chrono::ceil<std::chrono::milliseconds>(next - Clock::now()).count();
+
+  return static_cast<int>(std::clamp<decltype(wait)>(wait, 0, INT_MAX));
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::timeout()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::expire()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::expire()
+{
+  std::vector<Request> expired;
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    const Clock::time_point           now = Clock::now();
+
+    while (!this->queue.empty() && this->queue.front().deadline <= now)
+    {
+      expired.push_back(std::move(this->queue.front()));
+      this->queue.pop_front();
+    }
+  }
+
+  if (expired.empty())
+  {
+    return;
+  }
+
+  spdlog::warn("Async query engine dropped {} queries waiting longer than {} ms", expired.size(), this->maxWait.count());
+
+  for (Request& request : expired)
+  {
+    deliver(request, std::make_exception_ptr(repository::broken_connection("Async query waited longer than DBMAXWAIT")));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::expire()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::dispatch()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::dispatch()
+{
+  for (std::size_t index = 0; index < this->pool.size(); ++index)
+  {
+    if (this->pool[index].state != State::Idle)
+    {
+      continue;
+    }
+
+    std::optional<Request> request;
+
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->queue.empty())
+      {
+        return;
+      }
+
+      request.emplace(std::move(this->queue.front()));
+      this->queue.pop_front();
+    }
+
+    this->send(index, std::move(*request));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::dispatch()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::connect()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::connect(std::size_t index)
+{
+  Connection& connection = this->pool[index];
+
+  connection.conn = PQconnectStart(this->connectStr.c_str());
+
+  if (connection.conn == nullptr || PQstatus(connection.conn) == CONNECTION_BAD)
+  {
+    this->fail(index, errorOf(connection.conn));
+    return;
+  }
+
+  connection.state   = State::Connecting;
+  connection.retryAt = Clock::now() + this->connectTimeout;
+
+  this->watch(index, EPOLLOUT);                                                                     // As if PQconnectPoll asked for writing
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::connect()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::poll()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::poll(std::size_t index)
+{
+  Connection& connection = this->pool[index];
+
+  switch (PQconnectPoll(connection.conn))
+  {
+    case PGRES_POLLING_READING:
+      this->watch(index, EPOLLIN);
+      break;
+
+    case PGRES_POLLING_WRITING:
+      this->watch(index, EPOLLOUT);
+      break;
+
+    case PGRES_POLLING_OK:
+      if (PQsetnonblocking(connection.conn, 1) != 0)
+      {
+        this->fail(index, errorOf(connection.conn));
+        break;
+      }
+
+      connection.state   = State::Idle;
+      connection.backoff = std::chrono::milliseconds(0);
+      ++this->ready;
+
+      this->watch(index, EPOLLIN);                                                                  // Idle, readable means closed by the server
+
+      spdlog::debug("Async query engine connection {} ready", index);
+      break;
+
+    default:
+      this->fail(index, errorOf(connection.conn));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::poll()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::send()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::send(std::size_t index, Request&& request)
+{
+  Connection& connection = this->pool[index];
+
+  std::vector<const char*> values;
+  values.reserve(request.params.size());
+
+  for (const std::optional<std::string>& param : request.params)
+  {
+    values.push_back(param ? param->c_str() : nullptr);
+  }
+
+  const int sent = PQsendQueryParams(connection.conn,
+                                     request.sql.c_str(),
+                                     static_cast<int>(values.size()),
+                                     nullptr,                                                       // Types inferred by the server
+                                     values.empty() ? nullptr : values.data(),
+                                     nullptr,
+                                     nullptr,
+                                     0);                                                            // Text results
+
+  connection.running.emplace(std::move(request));
+
+  if (!sent)
+  {
+    const std::string error = errorOf(connection.conn);
+
+    if (PQstatus(connection.conn) == CONNECTION_BAD)
+    {
+      this->fail(index, error);
+      return;
+    }
+
+    Request refused = std::move(*connection.running);
+    connection.running.reset();
+
+    deliver(refused, std::make_exception_ptr(repository::broken_connection("Async query not sent: " + error)));
+    return;
+  }
+
+  connection.state = State::Busy;
+
+  this->flush(index);
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::send()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::flush()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::flush(std::size_t index)
+{
+  switch (PQflush(this->pool[index].conn))
+  {
+    case 0:
+      this->watch(index, EPOLLIN);
+      break;
+
+    case 1:
+      this->watch(index, EPOLLIN | EPOLLOUT);                                                       // The rest goes when the socket is writable
+      break;
+
+    default:
+      this->fail(index, errorOf(this->pool[index].conn));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::flush()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::receive()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::receive(std::size_t index)
+{
+  Connection& connection = this->pool[index];
+
+  if (connection.state != State::Idle && connection.state != State::Busy)
+  {
+    return;
+  }
+
+  if (!PQconsumeInput(connection.conn))
+  {
+    this->fail(index, errorOf(connection.conn));
+    return;
+  }
+
+  if (connection.state == State::Idle)
+  {
+    while (PGnotify* notify = PQnotifies(connection.conn))                                          // Nobody listens
+    {
+      PQfreemem(notify);
+    }
+
+    return;
+  }
+
+  while (!PQisBusy(connection.conn))
+  {
+    PGresult* result = PQgetResult(connection.conn);
+
+    if (result == nullptr)                                                                          // Statement done, connection free
+    {
+      Request request = std::move(*connection.running);
+      Result  last(connection.result);
+
+      connection.running.reset();
+      connection.result = nullptr;
+      connection.state  = State::Idle;
+
+      deliver(request, std::move(last));
+      return;
+    }
+
+    if (connection.result != nullptr && !succeeded(connection.result))                              // Keep the first error
+    {
+      PQclear(result);
+    }
+    else
+    {
+      PQclear(connection.result);
+      connection.result = result;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::receive()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::watch()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// libpq may switch socket while connecting, the new one replaces the old in epoll
+void AsyncEngine::watch(std::size_t index, std::uint32_t events)
+{
+  Connection& connection = this->pool[index];
+  const int   socket     = PQsocket(connection.conn);
+
+  if (socket != connection.socket && connection.socket >= 0)
+  {
+    epoll_ctl(this->epoll, EPOLL_CTL_DEL, connection.socket, nullptr);
+
+    connection.socket = -1;
+    connection.events = 0;
+  }
+
+  if (socket < 0)
+  {
+    this->fail(index, "no socket");
+    return;
+  }
+
+  if (socket == connection.socket && events == connection.events)
+  {
+    return;
+  }
+
+  epoll_event event{};
+  event.events   = events;
+  event.data.u64 = index;
+
+  if (epoll_ctl(this->epoll, connection.socket < 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, socket, &event) < 0)
+  {
+    this->fail(index, std::strerror(errno));
+    return;
+  }
+
+  connection.socket = socket;
+  connection.events = events;
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::watch()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::fail()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Closes the connection, fails the query it ran and schedules the next attempt
+void AsyncEngine::fail(std::size_t index, const std::string& error)
+{
+  Connection& connection = this->pool[index];
+
+  if (connection.socket >= 0)
+  {
+    epoll_ctl(this->epoll, EPOLL_CTL_DEL, connection.socket, nullptr);                            // Before PQfinish closes it
+  }
+
+  if (connection.state == State::Idle || connection.state == State::Busy)
+  {
+    --this->ready;
+  }
+
+  PQclear(connection.result);
+  PQfinish(connection.conn);
+
+  connection.result  = nullptr;
+  connection.conn    = nullptr;
+  connection.socket  = -1;
+  connection.events  = 0;
+  connection.state   = State::Broken;
+  connection.backoff = connection.backoff.count() == 0 ? this->backoffMin : std::min(connection.backoff * 2, this->backoffMax);
+  connection.retryAt = Clock::now() + connection.backoff;
+
+  spdlog::warn("Async query engine connection {} down, retry in {} ms: {}", index, connection.backoff.count(), error);
+
+  if (connection.running)
+  {
+    Request request = std::move(*connection.running);
+    connection.running.reset();
+
+    deliver(request, std::make_exception_ptr(repository::broken_connection("Async query connection lost: " + error)));
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::fail()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::deliver()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void AsyncEngine::deliver(Request& request, std::exception_ptr error)
+{
+  request.promise.set_exception(error);
+
+  notify(request);
+}
+
+
+
+// An error reported by the server throws pqxx::sql_error with its SQLSTATE
+void AsyncEngine::deliver(Request& request, Result&& result)
+{
+  if (!result.ok())
+  {
+    deliver(request, std::make_exception_ptr(pqxx::sql_error(result.error(), request.sql, result.sqlstate())));
+    return;
+  }
+
+  request.promise.set_value(std::move(result));
+
+  notify(request);
+}
+
+
+
+// Runs done, if any, on the loop thread
+void AsyncEngine::notify(Request& request)
+{
+  if (!request.done)
+  {
+    return;
+  }
+
+  try
+  {
+    request.done(request.promise.get_future());
+  }
+  catch (const std::exception& e)
+  {
+    spdlog::error("Async query callback threw: {}", e.what());
+  }
+  catch (...)
+  {
+    spdlog::error("Async query callback threw an unknown exception");
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::deliver()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of AsyncEngine::pending()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::size_t AsyncEngine::pending() const
+{
+  const std::lock_guard<std::mutex> lock(this->mutex);
+
+  return this->queue.size();
+}
+
+
+
+std::size_t AsyncEngine::connected() const
+{
+  return this->ready.load();
+}
+// -------------------------------------------------------------------------------------------------
+// End of AsyncEngine::pending()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
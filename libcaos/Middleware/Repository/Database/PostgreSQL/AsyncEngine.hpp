@@ -0,0 +1,201 @@
+#pragma once
+
+#include <libpq-fe.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../../Exception.hpp"
+
+// Non-blocking query engine on the asynchronous API of libpq.
+//
+// A few raw connections in non-blocking mode are driven by one loop thread waiting on epoll for
+// their sockets: a call only queues its statement and returns, the loop sends it with
+// PQsendQueryParams on the first idle connection, reads the reply with PQconsumeInput as it
+// arrives and hands the result over when PQgetResult completes it. Thousands of outstanding
+// queries cost a queue entry each, not a thread nor a pooled connection blocked on a round trip.
+//
+// At most queueMax queries wait for a connection: a query made while the queue is full is refused,
+// its future (or its callback, called on the calling thread before query() returns) gets
+// repository::broken_connection, so a burst the server can't keep up with doesn't pile up unbounded.
+//
+// A query still queued after maxWait fails with repository::broken_connection, as does the one
+// running on a connection that breaks; the connection is opened again after backoffMin, doubled
+// up to backoffMax while it keeps failing. libpq doesn't time out a non-blocking connect, an
+// attempt taking longer than connectTimeout is given up here. An error reported by the server throws
+// pqxx::sql_error, like the synchronous path.
+class AsyncEngine
+{
+  public:
+    // Owns the PGresult, values in text format
+    class Result
+    {
+      public:
+        Result() = default;
+        explicit Result(PGresult* result) noexcept : result(result) {}
+        ~Result() { PQclear(this->result); }
+
+        Result(Result&& other) noexcept : result(other.result) { other.result = nullptr; }
+        Result& operator=(Result&& other) noexcept
+        {
+          if (this != &other)
+          {
+            PQclear(this->result);
+            this->result = other.result;
+            other.result = nullptr;
+          }
+
+          return *this;
+        }
+
+        Result(const Result&)            = delete;
+        Result& operator=(const Result&) = delete;
+
+        [[nodiscard]] std::size_t rows()    const noexcept { return this->result ? static_cast<std::size_t>(PQntuples(this->result)) : 0; }
+        [[nodiscard]] std::size_t columns() const noexcept { return this->result ? static_cast<std::size_t>(PQnfields(this->result)) : 0; }
+        [[nodiscard]] bool        empty()   const noexcept { return this->rows() == 0; }
+
+        // False when the server reported an error
+        [[nodiscard]] bool ok() const noexcept
+        {
+          const ExecStatusType status = PQresultStatus(this->result);
+
+          return status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK || status == PGRES_EMPTY_QUERY;
+        }
+
+        [[nodiscard]] std::string error() const
+        {
+          std::string message = this->result ? PQresultErrorMessage(this->result) : "No result";
+
+          while (!message.empty() && (message.back() == '\n' || message.back() == ' '))
+          {
+            message.pop_back();
+          }
+
+          return message;
+        }
+
+        [[nodiscard]] const char* sqlstate() const noexcept
+        {
+          return this->result ? PQresultErrorField(this->result, PG_DIAG_SQLSTATE) : nullptr;
+        }
+
+        // Rows changed by INSERT, UPDATE, DELETE...
+        [[nodiscard]] std::size_t affected() const
+        {
+          const char* tuples = this->result ? PQcmdTuples(this->result) : "";
+
+          return *tuples ? std::stoul(tuples) : 0;
+        }
+
+        // Empty when the value is NULL, valid as long as the Result
+        [[nodiscard]] std::optional<std::string_view> value(std::size_t row, std::size_t column) const noexcept
+        {
+          const int r = static_cast<int>(row);
+          const int c = static_cast<int>(column);
+
+          if (PQgetisnull(this->result, r, c))
+          {
+            return std::nullopt;
+          }
+
+          return std::string_view(PQgetvalue(this->result, r, c), static_cast<std::size_t>(PQgetlength(this->result, r, c)));
+        }
+
+      private:
+        PGresult* result {nullptr};
+    };
+
+    using Params   = std::vector<std::optional<std::string>>;                                       // $1, $2... nullopt binds NULL
+    using Callback = std::function<void(std::future<Result>)>;
+
+    AsyncEngine(std::string                connectStr,
+                std::size_t                connections,
+                std::size_t                queueMax,
+                std::chrono::seconds       connectTimeout,
+                std::chrono::milliseconds  maxWait,
+                std::chrono::milliseconds  backoffMin,
+                std::chrono::milliseconds  backoffMax);
+    ~AsyncEngine();
+
+    AsyncEngine(const AsyncEngine&)            = delete;
+    AsyncEngine& operator=(const AsyncEngine&) = delete;
+
+    // Future of the result
+    [[nodiscard]] std::future<Result>                 query(std::string sql, Params params = {})  ;
+
+    // done gets the ready future on the loop thread: it must not block, hand long work over to
+    // an Executor
+    void                                              query(std::string sql, Params params, Callback done);
+
+    [[nodiscard]] std::size_t                         pending()                           const;     // Queued, not sent yet
+    [[nodiscard]] std::size_t                         connected()                         const;     // Connections ready or busy
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+      std::string                                     sql                                       ;
+      Params                                          params                                    ;
+      std::promise<Result>                            promise                                   ;
+      Callback                                        done                                      ;
+      Clock::time_point                               deadline                                  ;
+    };
+
+    enum class State: std::uint8_t { Broken, Connecting, Idle, Busy };
+
+    struct Connection {
+      PGconn*                                         conn                  {nullptr}           ;
+      State                                           state                 {State::Broken}     ;
+      int                                             socket                {-1}                ;     // Registered with epoll
+      std::uint32_t                                   events                {0}                 ;
+      std::optional<Request>                          running                                   ;
+      PGresult*                                       result                {nullptr}           ;     // Kept until PQgetResult returns null
+      Clock::time_point                               retryAt                                   ;     // Next attempt when Broken, give up when Connecting
+      std::chrono::milliseconds                       backoff               {0}                 ;
+    };
+
+    const std::string                                 connectStr                                ;
+    const std::size_t                                 queueMax                                  ;
+    const std::chrono::seconds                        connectTimeout                            ;
+    const std::chrono::milliseconds                   maxWait                                   ;
+    const std::chrono::milliseconds                   backoffMin                                ;
+    const std::chrono::milliseconds                   backoffMax                                ;
+
+    int                                               epoll                 {-1}                ;
+    int                                               wakeup                {-1}                ;     // eventfd, new requests or stop
+    std::vector<Connection>                           pool                                      ;     // Loop thread only
+    std::atomic<std::size_t>                          ready                 {0}                 ;
+
+    mutable std::mutex                                mutex                                     ;
+    std::deque<Request>                               queue                                     ;
+    bool                                              stopping              {false}             ;
+    std::thread                                       loop                                      ;
+
+    void                                              enqueue(Request&&)                        ;
+    void                                              run()                                     ;
+    int                                               timeout()                                 ;
+    void                                              expire()                                  ;
+    void                                              dispatch()                                ;
+    void                                              connect(std::size_t)                      ;
+    void                                              poll(std::size_t)                         ;
+    void                                              send(std::size_t, Request&&)              ;
+    void                                              flush(std::size_t)                        ;
+    void                                              receive(std::size_t)                      ;
+    void                                              watch(std::size_t, std::uint32_t)         ;
+    void                                              fail(std::size_t, const std::string&)     ;
+    static void                                       deliver(Request&, std::exception_ptr)     ;
+    static void                                       deliver(Request&, Result&&)               ;
+    static void                                       notify(Request&)                          ;
+};
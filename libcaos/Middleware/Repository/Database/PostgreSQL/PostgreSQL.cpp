@@ -8,6 +8,10 @@
 #include "../../src/include/Database/PostgreSQL/Query.hpp"
 #endif
 
+#include "generated_queries/Database_Query_Implementation.hpp"
+
+QUERY_IMPLEMENTATION_POSTGRESQL() /* <- from "generated_queries/Database_Query_Implementation.hpp" */
+
 constexpr const char* defaultFinal = "{} : Setting database {} to {} in {}  environment";
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -98,11 +102,12 @@ bool Database::Pool::validateConnection(const dbuniq& connection)
 
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-// Init of PostgreSQL::Pool::createConnection()
+// Init of PostgreSQL::Pool::openConnection()
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Database::Pool::createConnection(std::size_t& pool_size)
+// Dials and validates a new connection without touching the pool: runs on a factory thread
+dbuniq Database::Pool::openConnection()
 {
-  const char* fName = "PostgreSQL::Pool::createConnection";
+  const char* fName = "PostgreSQL::Pool::openConnection";
 
   static std::atomic<bool> loggedOnce {false};
 
@@ -110,33 +115,15 @@ void Database::Pool::createConnection(std::size_t& pool_size)
   {
     spdlog::debug("[{}] Creating new connection", fName);
 
-    if(!this->checkPoolSize(pool_size))                                                 // Don't saturate PostgreSQL connections
-    {
-      return;
-    }
-
-    Database::Pool::PoolData& pool = this->getPoolData();
-
     auto connection = std::make_unique<dbconn>(this->getConnectStr());
 
     if (this->validateConnection(connection))
     {
-      ConnectionMetrics metrics;
-
-      pool.connections.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(std::move(connection)),
-        std::forward_as_tuple(std::move(metrics))
-      );
-
-      spdlog::info("[{}] New valid connection created (total: {})",
-                  fName, this->getTotalConnections());
-
-      this->connectionRefused = false;
+      spdlog::debug("[{}] New valid connection created", fName);
 
       loggedOnce.store(false, std::memory_order_release);
 
-      return;
+      return connection;
     }
 
     connection->close();
@@ -161,9 +148,11 @@ void Database::Pool::createConnection(std::size_t& pool_size)
       loggedOnce.store(true, std::memory_order_release);
     }
   }
+
+  return nullptr;
 }
 // -------------------------------------------------------------------------------------------------
-// End of PostgreSQL::Pool::createConnection()
+// End of PostgreSQL::Pool::openConnection()
 // -------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------
 
@@ -189,13 +178,13 @@ void Database::Pool::closeConnection(const dbuniq& connection)
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
-      if (auto it = pool.connections.find(connection); it != pool.connections.end())
+      if (auto index = this->findSlot(connection.get(), lock); index.has_value())
       {
         connection->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -236,18 +225,15 @@ void Database::Pool::closeConnection(std::optional<Database::ConnectionWrapper>&
     {
       Database::Pool::PoolData& pool = this->getPoolData();
 
-      std::unique_lock<std::mutex> lock(pool.connections_mutex, std::try_to_lock);
+      std::unique_lock<std::mutex> lock;
 
       auto* raw = connection.value().get ();
-      auto it = std::find_if (pool.connections.begin(), pool.connections.end(), [raw](auto const& pair) {
-        return pair.first.get() == raw;
-      });
 
-      if (it != pool.connections.end())
+      if (auto index = this->findSlot(raw, lock); index.has_value())
       {
         raw->close();
-        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, it->second.usage_count);
-        it = pool.connections.erase(it);
+        spdlog::debug("[{}] Removed metrics for connection (used {} times)", fName, pool.slots[*index].metrics.usage_count);
+        this->removeConnection(*index);
 
         return;
       }
@@ -409,6 +395,72 @@ void Database::Pool::setKeepAlivesCount()
 
 
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setAsyncConnections()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setAsyncConnections()
+{
+  const char* fName     = "Database::Pool::setAsyncConnections"     ;
+  const char* fieldName = "DBASYNCCONNECTIONS"                      ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBASYNCCONNECTIONS_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.async_connections,                                 // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBASYNCCONNECTIONS_ENV_NAME,                               // envName
+    CAOS_DBASYNCCONNECTIONS_OPT_NAME,                               // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setAsyncConnections()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Database::Pool::setAsyncQueue()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Database::Pool::setAsyncQueue()
+{
+  const char* fName     = "Database::Pool::setAsyncQueue"           ;
+  const char* fieldName = "DBASYNCQUEUE"                            ;
+  using       dataType  = std::size_t                               ;
+
+  Policy::NumberAtLeast<dataType> validator(
+    fieldName,
+    CAOS_DBASYNCQUEUE_LIMIT_MIN
+  )                                                                 ;
+
+  configureValue<dataType>(
+    this->config.async_queue,                                       // configField
+    &TerminalOptions::get_instance(),                               // terminalPtr
+    CAOS_DBASYNCQUEUE_ENV_NAME,                                     // envName
+    CAOS_DBASYNCQUEUE_OPT_NAME,                                     // optName
+    fieldName,                                                      // fieldName
+    fName,                                                          // callerName
+    validator,                                                      // validator in namespace Policy
+    defaultFinal,
+    false                                                           // exitOnError
+  );
+}
+// -------------------------------------------------------------------------------------------------
+// End of Database::Pool::setAsyncQueue()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
 
 
 
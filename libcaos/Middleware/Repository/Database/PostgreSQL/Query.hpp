@@ -21,11 +21,12 @@ std::optional<std::string> PostgreSQL::IQuery_Example_echoString(std::string str
       pqxx::result result;
 
       {
-        pqxx::work tx(*connection);
+        const pqxx::prepped statement = connection.prepared("IQuery_Example_echoString", "SELECT  $1");
+
+        pqxx::nontransaction tx(*connection);                                    // Single SELECT: no BEGIN/COMMIT
         pqxx::params p;
         p.append(str);
-        result = tx.exec("SELECT  $1", p);/*pg_sleep(0.05),*/
-        tx.commit();
+        result = tx.exec(statement, p);/*pg_sleep(0.05),*/
       }
 
       if (!result.empty())
@@ -78,12 +79,13 @@ std::optional<std::string> PostgreSQL::IQuery_Example_echoString(std::string str
 //       pqxx::result result;
 
 //       {
-//         pqxx::work tx(*connection);
+//         const pqxx::prepped statement = connection.prepared("IQuery_Test_sumInt", "SELECT  $1+$2");
+//
+//         pqxx::nontransaction tx(*connection);                                    // Single SELECT: no BEGIN/COMMIT
 //         pqxx::params p;
 //         p.append(int1);
 //         p.append(int2);
-//         result = tx.exec("SELECT  $1+$2", p);/*pg_sleep(0.05),*/
-//         tx.commit();
+//         result = tx.exec(statement, p);/*pg_sleep(0.05),*/
 //       }
 
 //       if (!result.empty())
@@ -0,0 +1,305 @@
+#include "Telemetry.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::stripe()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::size_t Telemetry::stripe() noexcept
+{
+  static std::atomic<std::size_t> nextThread {0};
+
+  thread_local const std::size_t stripe = nextThread.fetch_add(1, std::memory_order_relaxed) % Histogram::stripeCount;
+
+  return stripe;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::stripe()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Histogram::bucketIndex()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Values below subBucketCount get a bucket each. Above, the magnitude (highest bit set) picks the
+// power of two and the next subBucketBits bits the linear sub-bucket inside it.
+std::size_t Telemetry::Histogram::bucketIndex(std::uint64_t value) noexcept
+{
+  static constexpr std::uint64_t highest = (std::uint64_t{1} << (maxMagnitude + 1)) - 1;
+
+  value = std::min(value, highest);                                                                 // Saturate, don't overflow
+
+  if (value < subBucketCount)
+  {
+    return static_cast<std::size_t>(value);
+  }
+
+#if defined(__GNUC__) || defined(__clang__)
+  const std::size_t magnitude = static_cast<std::size_t>(63 - __builtin_clzll(value));
+#else
+  std::size_t magnitude = subBucketBits;
+
+  while ((value >> (magnitude + 1)) != 0)
+  {
+    ++magnitude;
+  }
+#endif
+
+  const std::size_t shift = magnitude - subBucketBits;
+
+  return (shift + 1) * subBucketCount + static_cast<std::size_t>((value >> shift) - subBucketCount);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Histogram::bucketIndex()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Histogram::bucketUpperBound()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Highest value that lands in the bucket
+std::uint64_t Telemetry::Histogram::bucketUpperBound(std::size_t index) noexcept
+{
+  if (index < subBucketCount)
+  {
+    return index;
+  }
+
+  const std::size_t   shift = index / subBucketCount - 1;
+  const std::uint64_t top   = index % subBucketCount + subBucketCount;
+
+  return ((top + 1) << shift) - 1;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Histogram::bucketUpperBound()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Histogram::record()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Telemetry::Histogram::record(std::uint64_t value) noexcept
+{
+  Stripe& stripe = this->stripes[Telemetry::stripe()];
+
+  stripe.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  stripe.sum.fetch_add(value, std::memory_order_relaxed);
+
+  std::uint64_t seen = stripe.min.load(std::memory_order_relaxed);
+
+  while (value < seen && !stripe.min.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+  {
+  }
+
+  seen = stripe.max.load(std::memory_order_relaxed);
+
+  while (value > seen && !stripe.max.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+
+
+void Telemetry::Histogram::record(std::chrono::steady_clock::duration elapsed) noexcept
+{
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  this->record(static_cast<std::uint64_t>(std::max<decltype(micros)>(micros, 0)));
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Histogram::record()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Histogram::snapshot()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Not atomic as a whole: a value recorded while it runs may be counted but not yet summed
+Telemetry::Snapshot Telemetry::Histogram::snapshot() const
+{
+  Snapshot                                snap;
+  std::array<std::uint64_t, bucketCount>  totals {};
+
+  snap.min = std::numeric_limits<std::uint64_t>::max();
+
+  for (const Stripe& stripe : this->stripes)
+  {
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+      totals[i] += stripe.counts[i].load(std::memory_order_relaxed);
+    }
+
+    snap.sum += stripe.sum.load(std::memory_order_relaxed);
+    snap.min  = std::min(snap.min, stripe.min.load(std::memory_order_relaxed));
+    snap.max  = std::max(snap.max, stripe.max.load(std::memory_order_relaxed));
+  }
+
+  for (std::size_t i = 0; i < bucketCount; ++i)
+  {
+    if (totals[i] != 0)
+    {
+      snap.buckets.emplace_back(bucketUpperBound(i), totals[i]);
+      snap.count += totals[i];
+    }
+  }
+
+  if (snap.count == 0)
+  {
+    snap.min = 0;
+  }
+
+  return snap;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Histogram::snapshot()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Snapshot::mean()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+double Telemetry::Snapshot::mean() const noexcept
+{
+  if (this->count == 0)
+  {
+    return 0.0;
+  }
+
+  return static_cast<double>(this->sum) / static_cast<double>(this->count);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Snapshot::mean()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Snapshot::percentile()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Upper bound of the bucket holding the requested rank, capped by the largest value seen
+std::uint64_t Telemetry::Snapshot::percentile(double p) const noexcept
+{
+  if (this->count == 0)
+  {
+    return 0;
+  }
+
+  const double        rank   = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(this->count);
+  const std::uint64_t target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(rank)));
+
+  std::uint64_t seen = 0;
+
+  for (const auto& [upper, n] : this->buckets)
+  {
+    seen += n;
+
+    if (seen >= target)
+    {
+      return std::min(upper, this->max);
+    }
+  }
+
+  return this->max;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Snapshot::percentile()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Telemetry::Counter
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Telemetry::Counter::increment() noexcept
+{
+  this->stripes[Telemetry::stripe()].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+std::uint64_t Telemetry::Counter::value() const noexcept
+{
+  std::uint64_t total = 0;
+
+  for (const Stripe& stripe : this->stripes)
+  {
+    total += stripe.value.load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Telemetry::Counter
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Lock-free latency recording for the connection pool.
+//
+// Values are microseconds kept in log-linear buckets, the HdrHistogram layout: every power of two is
+// split into 32 linear sub-buckets, so any recorded value is known within about 3%. Writers are
+// spread over a few stripes picked per thread and every bucket is a relaxed atomic counter, so
+// recording never blocks and threads rarely share a cache line. snapshot() adds the stripes up.
+namespace Telemetry
+{
+  // One histogram at the time of the snapshot, values in microseconds
+  struct Snapshot
+  {
+    std::uint64_t                                         count                 {0}             ;
+    std::uint64_t                                         sum                   {0}             ;
+    std::uint64_t                                         min                   {0}             ;
+    std::uint64_t                                         max                   {0}             ;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>>  buckets                               ;     // Upper bound and count, non-empty only
+
+    [[nodiscard]] double                                  mean()                  const noexcept;
+    [[nodiscard]] std::uint64_t                           percentile(double)      const noexcept;     // 0.0 to 100.0
+  };
+
+  // Stripe of the calling thread, assigned round-robin on first use
+  [[nodiscard]] std::size_t                               stripe()                      noexcept;
+
+  class Histogram
+  {
+    public:
+      static constexpr std::size_t                        subBucketBits         {5}             ;
+      static constexpr std::size_t                        subBucketCount        {1u << subBucketBits};
+      static constexpr std::size_t                        maxMagnitude          {40}            ;     // 2^40 us, about 12 days
+      static constexpr std::size_t                        bucketCount           {(maxMagnitude - subBucketBits + 2) * subBucketCount};
+      static constexpr std::size_t                        stripeCount           {8}             ;
+
+      void                                                record(std::uint64_t)         noexcept;
+      void                                                record(std::chrono::steady_clock::duration) noexcept;
+      [[nodiscard]] Snapshot                              snapshot()              const         ;
+
+      [[nodiscard]] static std::size_t                    bucketIndex(std::uint64_t)    noexcept;
+      [[nodiscard]] static std::uint64_t                  bucketUpperBound(std::size_t) noexcept;
+
+    private:
+      struct alignas(64) Stripe
+      {
+        std::array<std::atomic<std::uint64_t>, bucketCount> counts              {}              ;
+        std::atomic<std::uint64_t>                        sum                   {0}             ;
+        std::atomic<std::uint64_t>                        min                   {std::numeric_limits<std::uint64_t>::max()};
+        std::atomic<std::uint64_t>                        max                   {0}             ;
+      };
+
+      std::array<Stripe, stripeCount>                     stripes                               ;
+  };
+
+  class Counter
+  {
+    public:
+      void                                                increment()                   noexcept;
+      [[nodiscard]] std::uint64_t                         value()                 const noexcept;
+
+    private:
+      struct alignas(64) Stripe
+      {
+        std::atomic<std::uint64_t>                        value                 {0}             ;
+      };
+
+      std::array<Stripe, Histogram::stripeCount>          stripes                               ;
+  };
+}
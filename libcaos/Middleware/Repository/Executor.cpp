@@ -0,0 +1,153 @@
+#include "Executor.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <spdlog/spdlog.h>
+
+
+
+
+
+
+
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Executor::Executor()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+Executor::Executor(std::size_t threads, std::size_t queueMax)
+  : queueMax(std::max<std::size_t>(queueMax, 1))
+{
+  threads = std::max<std::size_t>(threads, 1);
+
+  this->workers.reserve(threads);
+
+  for (std::size_t i = 0; i < threads; ++i)
+  {
+    this->workers.emplace_back(&Executor::work, this);
+  }
+
+  spdlog::info("Query executor started with {} threads, queue of {}", threads, this->queueMax);
+}
+// -------------------------------------------------------------------------------------------------
+// End of Executor::Executor()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Executor::~Executor()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+Executor::~Executor()
+{
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+
+  this->ready.notify_all();
+
+  for (std::thread& worker : this->workers)
+  {
+    if (worker.joinable())
+    {
+      worker.join();
+    }
+  }
+
+  spdlog::trace("Query executor stopped");
+}
+// -------------------------------------------------------------------------------------------------
+// End of Executor::~Executor()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Executor::post()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool Executor::post(std::function<void()> task)
+{
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (this->stopping || this->queue.size() >= this->queueMax)
+    {
+      spdlog::warn("Query executor refused a task: {} already queued", this->queue.size());
+      return false;
+    }
+
+    this->queue.push_back(std::move(task));
+  }
+
+  this->ready.notify_one();
+
+  return true;
+}
+// -------------------------------------------------------------------------------------------------
+// End of Executor::post()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Executor::work()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void Executor::work()
+{
+  while (true)
+  {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+
+      this->ready.wait(lock, [this]() { return this->stopping || !this->queue.empty(); });
+
+      if (this->queue.empty())                                                                      // Stopping and drained
+      {
+        return;
+      }
+
+      task = std::move(this->queue.front());
+      this->queue.pop_front();
+    }
+
+    try
+    {
+      task();                                                                                       // Query errors land in the future
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::error("Query executor task callback threw: {}", e.what());
+    }
+    catch (...)
+    {
+      spdlog::error("Query executor task callback threw an unknown exception");
+    }
+  }
+}
+// -------------------------------------------------------------------------------------------------
+// End of Executor::work()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
+
+
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Init of Executor::pending()
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+std::size_t Executor::pending() const
+{
+  const std::lock_guard<std::mutex> lock(this->mutex);
+
+  return this->queue.size();
+}
+// -------------------------------------------------------------------------------------------------
+// End of Executor::pending()
+// -------------------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Exception.hpp"
+
+// Bounded thread pool running the _async query variants.
+//
+// A fixed number of threads take tasks from a queue that holds at most queueMax of them: a task
+// submitted to a full queue is refused, its future (or its callback, called on the submitting thread
+// before submit() returns) gets repository::broken_connection, so a burst can't pile up unbounded
+// work nor threads. On destruction queued tasks still run, then the threads are joined.
+class Executor
+{
+  public:
+    Executor(std::size_t threads, std::size_t queueMax);
+    ~Executor();
+
+    Executor(const Executor&)            = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    template <typename Task>
+    using Result = std::invoke_result_t<std::decay_t<Task>&>;
+
+    // Future of what task returns or throws
+    template <typename Task>
+    [[nodiscard]] std::future<Result<Task>> submit(Task&& task)
+    {
+      auto job = std::make_shared<std::packaged_task<Result<Task>()>>(std::forward<Task>(task));
+      std::future<Result<Task>> future = job->get_future();
+
+      if (!this->post([job]() { (*job)(); }))
+      {
+        return refused<Result<Task>>();
+      }
+
+      return future;
+    }
+
+    // done gets the ready future of what task returns or throws, on the executor thread. A refused
+    // task never reaches it: done gets the error on the caller's thread, before submit() returns
+    template <typename Task, typename Done>
+    void submit(Task&& task, Done&& done)
+    {
+      auto job      = std::make_shared<std::packaged_task<Result<Task>()>>(std::forward<Task>(task));
+      auto callback = std::make_shared<std::decay_t<Done>>(std::forward<Done>(done));
+
+      if (!this->post([job, callback]() { (*job)(); (*callback)(job->get_future()); }))
+      {
+        (*callback)(refused<Result<Task>>());
+      }
+    }
+
+    [[nodiscard]] std::size_t                         pending()                           const;
+
+  private:
+    const std::size_t                                 queueMax                                  ;
+
+    mutable std::mutex                                mutex                                     ;
+    std::condition_variable                           ready                                     ;
+    std::deque<std::function<void()>>                 queue                                     ;
+    bool                                              stopping              {false}             ;
+    std::vector<std::thread>                          workers                                   ;
+
+    [[nodiscard]] bool                                post(std::function<void()>)                 ;
+    void                                              work()                                    ;
+
+    template <typename Value>
+    [[nodiscard]] static std::future<Value> refused()
+    {
+      std::promise<Value> promise;
+      promise.set_exception(std::make_exception_ptr(repository::broken_connection("Query executor queue full")));
+
+      return promise.get_future();
+    }
+};
@@ -59,26 +59,109 @@
  * When implementing a query in a Cache backend (e.g., Redis), you have access to:
  * - The cache client: **`this->redis`** - Provides access to cache operations
  * - The database accessor: **`this->database`** - For cache-aside patterns
+ * - **`this->fill(key, ttl, value)`** - Stores a database result without waiting for Redis,
+ *   a failed store is only logged
+ * - **`this->getAsync(key)`** - GET returning a future, or calling back, also on the Cache
+ *
+ * Both run on redis++ `AsyncRedis` when libuv is found at build time
+ * (`CAOS_USE_CACHE_REDIS_ASYNC`). Otherwise `getAsync()` runs on the query executor
+ * and fills on a thread of their own, with up to `CAOS_CACHEEXECUTORQUEUE` of them
+ * queued: past that they are dropped with a warning, never taking an `_async` slot.
  *
  * 2.  DATABASE LAYER IMPLEMENTATION:
  *
  * When implementing a query in a Database backend, you have access to:
  * - The database pool: **`this->database`** - Use `acquire()` to get a connection
  * - The connection object for executing SQL queries
+ * - **`connection.prepared(name, sql)`** - Statement prepared once per pooled connection
+ *   and cached there, so repeated calls skip parsing and planning on the server
+ * - **`database->asyncEngine()`** - PostgreSQL only, null unless `CAOS_DBASYNCCONNECTIONS`
+ *   is set: `query(sql, params)` queues the statement and returns a future (or calls back on
+ *   the engine thread), one epoll loop multiplexes every pending call over those connections.
+ *   Once `CAOS_DBASYNCQUEUE` calls wait for one, new calls fail with
+ *   `repository::broken_connection`
+ *
+ * A query declared with `access: read` gets its connection from a read replica
+ * when `CAOS_DBREPLICAS` lists any, so it must not write nor expect to see a
+ * write made just before on the primary.
+ *
+ * `max_concurrency: N` caps how many calls of a query run at once and `reserved: N`
+ * keeps N pool connections for that query alone. Both are enforced by the Database
+ * forwarding layer before the backend calls `acquire()`; a call that can't get a
+ * permit and then a connection within one `CAOS_DBMAXWAIT` throws
+ * `repository::broken_connection`. Reserved connections are the primary's: a read
+ * routed to a replica needs no shared permit, only its `max_concurrency` slot. The
+ * reservation of a coalesced lookup goes to its `_batch` variant, the only one it calls.
+ *
+ * A query declaring `sql` needs no hand-written backend code: the generator writes
+ * it, parameters are bound by name (`:str`) and `result` picks what is returned
+ * (`scalar`, `column`, `exists`, `affected`, `none`, `stream`, `rows` or `row`), by
+ * default from the return type: `affected` for a `std::size_t`. `stream` adds a sink
+ * parameter, so only an explicit `result: stream` picks it. `sql` is one statement
+ * for every backend or one per backend (`postgresql`, `mysql`, `mariadb`); a backend
+ * left out keeps its manual Query.hpp.
+ *
+ * `transaction` sets how generated SQL runs: `none` and `read_only` (the default for
+ * `access: read`) in autocommit with no BEGIN/COMMIT, `read_write` (the default
+ * otherwise) in a READ COMMITTED transaction and `serializable` in a SERIALIZABLE one.
+ * On MySQL/MariaDB the isolation level is only set again when a connection changes it.
+ *
+ * `batchable: true` on a lookup (one parameter, `sql` as `<column> = :key`, `result:
+ * scalar`) adds `<name>_batch(const std::vector<Key>&)`, values returned in key order.
+ * The database runs one `= ANY($1)` (PostgreSQL) or `IN (...)` (MySQL/MariaDB) query
+ * for all the keys; with `cache: {prefix, ttl}` Redis answers hits with one MGET and
+ * stores the misses with `fill()`, without waiting. Keep the hand-written single lookup on
+ * the same `prefix + key` so both variants share the cache entries.
+ *
+ * `coalesce` on a batchable lookup makes the Cache forwarding layer merge concurrent
+ * calls: the first one waits `window_us` (200 by default) or until `max_keys` (64)
+ * callers joined, then one `_batch` call serves them all and each gets its own value.
+ * The single lookup's hand-written backend code is no longer called from the Cache.
+ *
+ * `row: {name, columns}` declares a struct with one typed member per column (`std::optional<T>`
+ * when the column is nullable); the query returns `std::vector<Name>` (`result: rows`) or
+ * `std::optional<Name>` (`result: row`, the first row). Columns are decoded by position in the
+ * select list straight into the members, a NULL leaves the member at its default.
+ *
+ * `ingest: <table>` with a `row` (and `access: write`, no `sql` nor parameters) makes a bulk
+ * load: the query takes `const std::vector<Name>& rows`, writes them into the table's columns
+ * named like the members and returns how many. PostgreSQL sends them all in one `COPY FROM
+ * STDIN`; MySQL runs a multi-row INSERT and MariaDB an array-bound batch (`useBulkStmts`) every
+ * `CAOS_DBINGESTBATCH` rows, all in the query's transaction.
+ *
+ * `result: stream` (return type `std::size_t`) is for result sets too large to hold: the query
+ * takes a `const repository::RowSink& sink` after its parameters and each row goes to it as
+ * soon as it is read, the number of rows delivered is returned. PostgreSQL runs the statement as
+ * `COPY (...) TO STDOUT` with the parameters quoted in, MySQL/MariaDB read an unbuffered result
+ * set. The sink returns false to stop early. Redis forwards it to the database, nothing is cached.
+ *
+ * `single_flight: true` on an `access: read` query makes calls with the same arguments,
+ * made while one of them runs, wait for that one's result instead of running again:
+ * when a popular entry expires the database sees one query, not one per caller.
+ *
+ * Every query also gets two `<name>_async` variants on the Cache, run by a bounded
+ * executor (`CAOS_CACHEEXECUTORTHREADS` threads, `CAOS_CACHEEXECUTORQUEUE` queued calls):
+ * one returns a `std::future`, the other takes a callback receiving the ready future on
+ * an executor thread. A call made while the queue is full fails with
+ * `repository::broken_connection` instead of waiting.
  *
  * 3.  GENERATED FILES:
  *
  * The following files are automatically generated and should NOT be edited manually:
+ * - `Query_Rows.hpp` - Row structs declared by the queries
  * - `Query_Definition.hpp` - Pure virtual declarations for IQuery
  * - `Query_Override.hpp` - Override declarations for intermediate classes
  * - `Cache_Query_Forwarding.hpp` - Forwarding implementations for Cache
+ * - `Cache_Query_Async.hpp` - `_async` variants of every query on the Cache
+ * - `Cache_Query_Implementation.hpp` - Redis implementations of the `_batch` variants and streams
  * - `Database_Query_Forwarding.hpp` - Forwarding implementations for Database
+ * - `Database_Query_Implementation.hpp` - Backend implementations of queries declaring `sql`
  *
  * 4.  MANUAL IMPLEMENTATIONS:
  *
- * Backend-specific implementations must be provided manually in the respective
- * backend Query.hpp files. The method signatures will match the generated
- * declarations exactly.
+ * Backend-specific implementations of queries without `sql` must be provided
+ * manually in the respective backend Query.hpp files. The method signatures will
+ * match the generated declarations exactly.
  *
  * ====================================================================
  * BACKEND SUPPORT
@@ -92,6 +175,8 @@
  */
 
 #pragma once
+#include "Stream.hpp"
+#include "generated_queries/Query_Rows.hpp"
 #include "generated_queries/Query_Definition.hpp"
 
 class IQuery
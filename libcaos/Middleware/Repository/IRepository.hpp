@@ -9,7 +9,9 @@
 #include <terminal_options.hpp>
 
 #include <arpa/inet.h>                                                                              // Validate IP address
+#include <limits>
 #include <type_traits>
+#include <vector>
 
 namespace detail                                                                                    // Type Check Utility for std::chrono::duration
 {
@@ -105,6 +107,104 @@ namespace Policy
       }
   };
 
+  class EndpointListValidator
+  {
+    private:
+      std::string shortVarName {"Policy::EndpointListValidator::shortVarName undefined"};
+      std::vector<std::pair<std::string, std::uint16_t>>& endpoints;
+      std::uint16_t defaultPort {0};
+
+    public:
+      EndpointListValidator(const std::string& shortVarName_,
+                            std::vector<std::pair<std::string, std::uint16_t>>& endpoints_,
+                            std::uint16_t defaultPort_)
+        : shortVarName(shortVarName_),
+          endpoints(endpoints_),
+          defaultPort(defaultPort_)
+      {}
+
+      // "host[:port],host[:port]...", IPv6 hosts as "[host]:port". An empty list is allowed
+      void operator()(const std::string& list) const
+      {
+        this->endpoints.clear();
+
+        std::size_t begin = 0;
+
+        while (begin < list.size())
+        {
+          std::size_t end = list.find(',', begin);
+
+          if (end == std::string::npos)
+          {
+            end = list.size();
+          }
+
+          std::string entry = list.substr(begin, end - begin);
+          begin = end + 1;
+
+          entry.erase(0, entry.find_first_not_of(" \t"));
+          entry.erase(entry.find_last_not_of(" \t") + 1);
+
+          if (entry.empty())
+          {
+            continue;
+          }
+
+          // Split ---------------------------------------------------------------------------------
+          std::string host = entry;
+          std::string port;
+
+          if (entry.front() == '[')                                                                 // [IPv6]:port
+          {
+            const std::size_t close = entry.find(']');
+
+            if (close == std::string::npos || (close + 1 < entry.size() && entry[close + 1] != ':'))
+            {
+              throw std::invalid_argument(this->shortVarName + " malformed entry: " + entry);
+            }
+
+            host = entry.substr(1, close - 1);
+            port = close + 2 <= entry.size() ? entry.substr(close + 2) : "";
+          }
+          else if (entry.find(':') == entry.rfind(':') && entry.find(':') != std::string::npos)   // IPv4:port
+          {
+            host = entry.substr(0, entry.find(':'));
+            port = entry.substr(entry.find(':') + 1);
+          }
+          // -----------------------------------------------------------------------------------------
+
+
+
+          // Validation ------------------------------------------------------------------------------
+          HostValidator{this->shortVarName}(host);
+
+          std::uint16_t number = this->defaultPort;
+
+          if (!port.empty())
+          {
+            if (port.find_first_not_of("0123456789") != std::string::npos || port.size() > 5)
+            {
+              throw std::invalid_argument(this->shortVarName + " invalid port in entry: " + entry);
+            }
+
+            const unsigned long value = std::stoul(port);
+
+            if (value > std::numeric_limits<std::uint16_t>::max())
+            {
+              throw std::invalid_argument(this->shortVarName + " invalid port in entry: " + entry);
+            }
+
+            number = static_cast<std::uint16_t>(value);
+          }
+
+          PortValidator{this->shortVarName}(number);
+          // -----------------------------------------------------------------------------------------
+
+          this->endpoints.emplace_back(host, number);
+        }
+      }
+  };
+
   class ThreadsValidator
   {
     private:
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Rows of a query declared with result: stream.
+//
+// The backend reads the result set a row at a time (COPY on PostgreSQL, an unbuffered result set
+// on MySQL/MariaDB) and hands each row to the sink before reading the next one: memory stays at one
+// row however many the query returns. The row is overwritten by the next one, copy what must be
+// kept. Values are in text format, nullopt for NULL.
+namespace repository
+{
+  using Row     = std::vector<std::optional<std::string>>;
+
+  // Returns false to stop early: the rows left are still read off the connection, and dropped
+  using RowSink = std::function<bool(const Row&)>;
+}
@@ -168,10 +168,14 @@ endif()
 message(STATUS "Query generation completed successfully")
 
 # Set generated files
+set(GENERATED_QUERY_ROWS "${GENERATED_QUERIES_DIR}/Query_Rows.hpp")
 set(GENERATED_QUERY_DEFINITION "${GENERATED_QUERIES_DIR}/Query_Definition.hpp")
 set(GENERATED_QUERY_OVERRIDE "${GENERATED_QUERIES_DIR}/Query_Override.hpp")
 set(GENERATED_CACHE_FORWARDING "${GENERATED_QUERIES_DIR}/Cache_Query_Forwarding.hpp")
+set(GENERATED_CACHE_ASYNC "${GENERATED_QUERIES_DIR}/Cache_Query_Async.hpp")
+set(GENERATED_CACHE_IMPLEMENTATION "${GENERATED_QUERIES_DIR}/Cache_Query_Implementation.hpp")
 set(GENERATED_DATABASE_FORWARDING "${GENERATED_QUERIES_DIR}/Database_Query_Forwarding.hpp")
+set(GENERATED_DATABASE_IMPLEMENTATION "${GENERATED_QUERIES_DIR}/Database_Query_Implementation.hpp")
 set(GENERATED_AUTH_CONFIG "${GENERATED_QUERIES_DIR}/AuthConfig.hpp")
 set(GENERATED_QUERY_CONFIG "${GENERATED_QUERIES_DIR}/Query_Config.cmake")
 
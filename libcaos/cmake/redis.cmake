@@ -57,6 +57,19 @@ else()
   message(FATAL_ERROR "HiRedis library not found. Install with: sudo apt-get install libhiredis-dev")
 endif()
 
+# --------------------------------------------------------------------------------------------------
+# 1b. FIND LIBUV, EVENT LOOP OF THE REDIS++ ASYNC INTERFACE
+# --------------------------------------------------------------------------------------------------
+pkg_check_modules(LIBUV_PKG QUIET libuv)
+
+if(LIBUV_PKG_FOUND)
+  message(STATUS "Found libuv (version: ${LIBUV_PKG_VERSION}), redis-plus-plus async interface enabled")
+  set(REDISPP_ASYNC "libuv")
+else()
+  message(STATUS "libuv not found, cache fills go through the query executor")
+  set(REDISPP_ASYNC "")
+endif()
+
 # --------------------------------------------------------------------------------------------------
 # 2. DETECT OR BUILD REDIS++ FROM SOURCE
 # --------------------------------------------------------------------------------------------------
@@ -83,13 +96,13 @@ else()
 
   if(HIREDIS_PKG_FOUND)
     execute_process(
-      COMMAND bash -c "PKG_CONFIG_PATH=${HIREDIS_PKG_PREFIX}/lib/pkgconfig ${CMAKE_CURRENT_SOURCE_DIR}/vendor/build-scripts/build_redispp.sh system"
+      COMMAND bash -c "PKG_CONFIG_PATH=${HIREDIS_PKG_PREFIX}/lib/pkgconfig REDISPP_ASYNC=${REDISPP_ASYNC} ${CMAKE_CURRENT_SOURCE_DIR}/vendor/build-scripts/build_redispp.sh system"
       WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
       RESULT_VARIABLE redispp_build_result
     )
 else()
   execute_process(
-    COMMAND ${CMAKE_CURRENT_SOURCE_DIR}/vendor/build-scripts/build_redispp.sh ${HIREDIS_INSTALL_DIR_FOR_REDISPP}
+    COMMAND ${CMAKE_COMMAND} -E env REDISPP_ASYNC=${REDISPP_ASYNC} ${CMAKE_CURRENT_SOURCE_DIR}/vendor/build-scripts/build_redispp.sh ${HIREDIS_INSTALL_DIR_FOR_REDISPP}
     WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
     RESULT_VARIABLE redispp_build_result
   )
@@ -141,6 +154,15 @@ target_link_libraries(redispp_suppressed INTERFACE
 # --------------------------------------------------------------------------------------------------
 target_link_libraries(${PROJECT_NAME} PRIVATE redispp_suppressed hiredis_suppressed)
 
+# A pre-built redis-plus-plus may lack the async interface: its headers tell
+if(LIBUV_PKG_FOUND AND EXISTS ${REDISPP_INSTALL_DIR}/include/sw/redis++/async_redis++.h)
+  target_compile_definitions(${PROJECT_NAME} PUBLIC CAOS_USE_CACHE_REDIS_ASYNC)
+  target_link_libraries(${PROJECT_NAME} PRIVATE ${LIBUV_PKG_LINK_LIBRARIES})
+  target_include_directories(${PROJECT_NAME} SYSTEM PUBLIC ${LIBUV_PKG_INCLUDE_DIRS})
+elseif(LIBUV_PKG_FOUND)
+  message(STATUS "redis-plus-plus built without async interface, cache fills go through the query executor")
+endif()
+
 target_include_directories(${PROJECT_NAME} SYSTEM PUBLIC
   ${REDISPP_INSTALL_DIR}/include
 )
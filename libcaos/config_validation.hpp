@@ -572,6 +572,28 @@ static_assert(is_non_null_and_non_empty_string(CAOS_LOG_SYSLOG_PATTERN), CAOS_LO
 
 
 
+  // CAOS_CACHEEXECUTORTHREADS_ENV_NAME ------------------------------------------------------------
+  #ifndef CAOS_CACHEEXECUTORTHREADS_ENV_NAME
+    #define CAOS_CACHEEXECUTORTHREADS_ENV_NAME "CAOS_CACHEEXECUTORTHREADS"
+  #endif
+
+  #define CAOS_CACHEEXECUTORTHREADS_ENV_NAME_ERRMSG "CAOS_CACHEEXECUTORTHREADS_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_CACHEEXECUTORTHREADS_ENV_NAME), CAOS_CACHEEXECUTORTHREADS_ENV_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // CAOS_CACHEEXECUTORQUEUE_ENV_NAME --------------------------------------------------------------
+  #ifndef CAOS_CACHEEXECUTORQUEUE_ENV_NAME
+    #define CAOS_CACHEEXECUTORQUEUE_ENV_NAME "CAOS_CACHEEXECUTORQUEUE"
+  #endif
+
+  #define CAOS_CACHEEXECUTORQUEUE_ENV_NAME_ERRMSG "CAOS_CACHEEXECUTORQUEUE_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_CACHEEXECUTORQUEUE_ENV_NAME), CAOS_CACHEEXECUTORQUEUE_ENV_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
 
 
   // CAOS_CACHEUSER_OPT_NAME -----------------------------------------------------------------------
@@ -718,6 +740,28 @@ static_assert(is_non_null_and_non_empty_string(CAOS_LOG_SYSLOG_PATTERN), CAOS_LO
 
 
 
+  // CAOS_CACHEEXECUTORTHREADS_OPT_NAME ------------------------------------------------------------
+  #ifndef CAOS_CACHEEXECUTORTHREADS_OPT_NAME
+    #define CAOS_CACHEEXECUTORTHREADS_OPT_NAME "cacheexecutorthreads"
+  #endif
+
+  #define CAOS_CACHEEXECUTORTHREADS_OPT_NAME_ERRMSG "CAOS_CACHEEXECUTORTHREADS_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_CACHEEXECUTORTHREADS_OPT_NAME), CAOS_CACHEEXECUTORTHREADS_OPT_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // CAOS_CACHEEXECUTORQUEUE_OPT_NAME --------------------------------------------------------------
+  #ifndef CAOS_CACHEEXECUTORQUEUE_OPT_NAME
+    #define CAOS_CACHEEXECUTORQUEUE_OPT_NAME "cacheexecutorqueue"
+  #endif
+
+  #define CAOS_CACHEEXECUTORQUEUE_OPT_NAME_ERRMSG "CAOS_CACHEEXECUTORQUEUE_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_CACHEEXECUTORQUEUE_OPT_NAME), CAOS_CACHEEXECUTORQUEUE_OPT_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
   // Default values
 
 
@@ -1008,6 +1052,48 @@ static_assert(is_non_null_and_non_empty_string(CAOS_LOG_SYSLOG_PATTERN), CAOS_LO
   static_assert(is_number_non_null_and_at_least<CAOS_CACHEPOOLCONNECTIONIDLETIME>(CAOS_CACHEPOOLCONNECTIONIDLETIME_LIMIT_MIN), CAOS_CACHEPOOLCONNECTIONIDLETIME_ERRMSG);
   //------------------------------------------------------------------------------------------------
 
+
+
+  // Cache async query executor threads ------------------------------------------------------------
+  #define CAOS_CACHEEXECUTORTHREADS_DEFAULT 8
+  #define CAOS_CACHEEXECUTORTHREADS_LIMIT_MIN 1
+
+  #ifdef CAOS_ENV_ALT                                                                               // CAOS_ENV="test" or CAOS_ENV="debug"
+    #ifdef CAOS_CACHEEXECUTORTHREADS_ALT
+      #undef CAOS_CACHEEXECUTORTHREADS
+      #define CAOS_CACHEEXECUTORTHREADS CAOS_CACHEEXECUTORTHREADS_ALT
+    #endif
+  #endif
+
+  #ifndef CAOS_CACHEEXECUTORTHREADS
+    #define CAOS_CACHEEXECUTORTHREADS CAOS_CACHEEXECUTORTHREADS_DEFAULT
+  #endif
+
+  #define CAOS_CACHEEXECUTORTHREADS_ERRMSG "CAOS_CACHEEXECUTORTHREADS" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_CACHEEXECUTORTHREADS_LIMIT_MIN)
+  static_assert(is_number_non_null_and_at_least<CAOS_CACHEEXECUTORTHREADS>(CAOS_CACHEEXECUTORTHREADS_LIMIT_MIN), CAOS_CACHEEXECUTORTHREADS_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // Cache async query executor queue --------------------------------------------------------------
+  #define CAOS_CACHEEXECUTORQUEUE_DEFAULT 1024
+  #define CAOS_CACHEEXECUTORQUEUE_LIMIT_MIN 1
+
+  #ifdef CAOS_ENV_ALT                                                                               // CAOS_ENV="test" or CAOS_ENV="debug"
+    #ifdef CAOS_CACHEEXECUTORQUEUE_ALT
+      #undef CAOS_CACHEEXECUTORQUEUE
+      #define CAOS_CACHEEXECUTORQUEUE CAOS_CACHEEXECUTORQUEUE_ALT
+    #endif
+  #endif
+
+  #ifndef CAOS_CACHEEXECUTORQUEUE
+    #define CAOS_CACHEEXECUTORQUEUE CAOS_CACHEEXECUTORQUEUE_DEFAULT
+  #endif
+
+  #define CAOS_CACHEEXECUTORQUEUE_ERRMSG "CAOS_CACHEEXECUTORQUEUE" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_CACHEEXECUTORQUEUE_LIMIT_MIN)
+  static_assert(is_number_non_null_and_at_least<CAOS_CACHEEXECUTORQUEUE>(CAOS_CACHEEXECUTORQUEUE_LIMIT_MIN), CAOS_CACHEEXECUTORQUEUE_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
 #endif
 //--------------------------------------------------------------------------------------------------
 // End Of CAOS_USE_CACHE
@@ -1167,6 +1253,28 @@ static_assert(is_non_null_and_non_empty_string(CAOS_DBPOOLTIMEOUT_ENV_NAME), CAO
   static_assert(is_non_null_and_non_empty_string(CAOS_DBKEEPALIVES_COUNT_ENV_NAME), CAOS_DBKEEPALIVES_COUNT_ENV_NAME_ERRMSG);
   //------------------------------------------------------------------------------------------------
 
+
+
+  // CAOS_DBASYNCCONNECTIONS_ENV_NAME --------------------------------------------------------------
+  #ifndef CAOS_DBASYNCCONNECTIONS_ENV_NAME
+    #define CAOS_DBASYNCCONNECTIONS_ENV_NAME "CAOS_DBASYNCCONNECTIONS"
+  #endif
+
+  #define CAOS_DBASYNCCONNECTIONS_ENV_NAME_ERRMSG "CAOS_DBASYNCCONNECTIONS_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_DBASYNCCONNECTIONS_ENV_NAME), CAOS_DBASYNCCONNECTIONS_ENV_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // CAOS_DBASYNCQUEUE_ENV_NAME --------------------------------------------------------------------
+  #ifndef CAOS_DBASYNCQUEUE_ENV_NAME
+    #define CAOS_DBASYNCQUEUE_ENV_NAME "CAOS_DBASYNCQUEUE"
+  #endif
+
+  #define CAOS_DBASYNCQUEUE_ENV_NAME_ERRMSG "CAOS_DBASYNCQUEUE_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_DBASYNCQUEUE_ENV_NAME), CAOS_DBASYNCQUEUE_ENV_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
 #endif // End Of CAOS_USE_DB_POSTGRESQL
 
 // CAOS_DBCONNECT_TIMEOUT_ENV_NAME -----------------------------------------------------------------
@@ -1202,6 +1310,94 @@ static_assert(is_non_null_and_non_empty_string(CAOS_DBHEALTHCHECKINTERVAL_ENV_NA
 
 
 
+// CAOS_DBCONNECT_PARALLELISM_ENV_NAME -------------------------------------------------------------
+#ifndef CAOS_DBCONNECT_PARALLELISM_ENV_NAME
+  #define CAOS_DBCONNECT_PARALLELISM_ENV_NAME "CAOS_DBCONNECT_PARALLELISM"
+#endif
+
+#define CAOS_DBCONNECT_PARALLELISM_ENV_NAME_ERRMSG "CAOS_DBCONNECT_PARALLELISM_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBCONNECT_PARALLELISM_ENV_NAME), CAOS_DBCONNECT_PARALLELISM_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBPOOLSHARDS_ENV_NAME ----------------------------------------------------------------------
+#ifndef CAOS_DBPOOLSHARDS_ENV_NAME
+  #define CAOS_DBPOOLSHARDS_ENV_NAME "CAOS_DBPOOLSHARDS"
+#endif
+
+#define CAOS_DBPOOLSHARDS_ENV_NAME_ERRMSG "CAOS_DBPOOLSHARDS_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBPOOLSHARDS_ENV_NAME), CAOS_DBPOOLSHARDS_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBTHREADAFFINITY_ENV_NAME ------------------------------------------------------------------
+#ifndef CAOS_DBTHREADAFFINITY_ENV_NAME
+  #define CAOS_DBTHREADAFFINITY_ENV_NAME "CAOS_DBTHREADAFFINITY"
+#endif
+
+#define CAOS_DBTHREADAFFINITY_ENV_NAME_ERRMSG "CAOS_DBTHREADAFFINITY_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBTHREADAFFINITY_ENV_NAME), CAOS_DBTHREADAFFINITY_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBREPLICAS_ENV_NAME ------------------------------------------------------------------------
+#ifndef CAOS_DBREPLICAS_ENV_NAME
+  #define CAOS_DBREPLICAS_ENV_NAME "CAOS_DBREPLICAS"
+#endif
+
+#define CAOS_DBREPLICAS_ENV_NAME_ERRMSG "CAOS_DBREPLICAS_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBREPLICAS_ENV_NAME), CAOS_DBREPLICAS_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERTHRESHOLD_ENV_NAME ----------------------------------------------------------------
+#ifndef CAOS_DBBREAKERTHRESHOLD_ENV_NAME
+  #define CAOS_DBBREAKERTHRESHOLD_ENV_NAME "CAOS_DBBREAKERTHRESHOLD"
+#endif
+
+#define CAOS_DBBREAKERTHRESHOLD_ENV_NAME_ERRMSG "CAOS_DBBREAKERTHRESHOLD_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERTHRESHOLD_ENV_NAME), CAOS_DBBREAKERTHRESHOLD_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERBACKOFFMIN_ENV_NAME ---------------------------------------------------------------
+#ifndef CAOS_DBBREAKERBACKOFFMIN_ENV_NAME
+  #define CAOS_DBBREAKERBACKOFFMIN_ENV_NAME "CAOS_DBBREAKERBACKOFFMIN"
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMIN_ENV_NAME_ERRMSG "CAOS_DBBREAKERBACKOFFMIN_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERBACKOFFMIN_ENV_NAME), CAOS_DBBREAKERBACKOFFMIN_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERBACKOFFMAX_ENV_NAME ---------------------------------------------------------------
+#ifndef CAOS_DBBREAKERBACKOFFMAX_ENV_NAME
+  #define CAOS_DBBREAKERBACKOFFMAX_ENV_NAME "CAOS_DBBREAKERBACKOFFMAX"
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMAX_ENV_NAME_ERRMSG "CAOS_DBBREAKERBACKOFFMAX_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERBACKOFFMAX_ENV_NAME), CAOS_DBBREAKERBACKOFFMAX_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBINGESTBATCH_ENV_NAME ---------------------------------------------------------------------
+#ifndef CAOS_DBINGESTBATCH_ENV_NAME
+  #define CAOS_DBINGESTBATCH_ENV_NAME "CAOS_DBINGESTBATCH"
+#endif
+
+#define CAOS_DBINGESTBATCH_ENV_NAME_ERRMSG "CAOS_DBINGESTBATCH_ENV_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBINGESTBATCH_ENV_NAME), CAOS_DBINGESTBATCH_ENV_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
 // CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_ENV_NAME -------------------------------------------
 #ifndef CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_ENV_NAME
   #define CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_ENV_NAME "CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED"
@@ -1378,6 +1574,28 @@ static_assert(is_non_null_and_non_empty_string(CAOS_DBPOOLTIMEOUT_OPT_NAME), CAO
   static_assert(is_non_null_and_non_empty_string(CAOS_DBKEEPALIVES_COUNT_OPT_NAME), CAOS_DBKEEPALIVES_COUNT_OPT_NAME_ERRMSG);
   //------------------------------------------------------------------------------------------------
 
+
+
+  // CAOS_DBASYNCCONNECTIONS_OPT_NAME --------------------------------------------------------------
+  #ifndef CAOS_DBASYNCCONNECTIONS_OPT_NAME
+    #define CAOS_DBASYNCCONNECTIONS_OPT_NAME "dbasyncconnections"
+  #endif
+
+  #define CAOS_DBASYNCCONNECTIONS_OPT_NAME_ERRMSG "CAOS_DBASYNCCONNECTIONS_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_DBASYNCCONNECTIONS_OPT_NAME), CAOS_DBASYNCCONNECTIONS_OPT_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // CAOS_DBASYNCQUEUE_OPT_NAME --------------------------------------------------------------------
+  #ifndef CAOS_DBASYNCQUEUE_OPT_NAME
+    #define CAOS_DBASYNCQUEUE_OPT_NAME "dbasyncqueue"
+  #endif
+
+  #define CAOS_DBASYNCQUEUE_OPT_NAME_ERRMSG "CAOS_DBASYNCQUEUE_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+  static_assert(is_non_null_and_non_empty_string(CAOS_DBASYNCQUEUE_OPT_NAME), CAOS_DBASYNCQUEUE_OPT_NAME_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
 #endif // End Of CAOS_USE_DB_POSTGRESQL
 
 
@@ -1416,6 +1634,94 @@ static_assert(is_non_null_and_non_empty_string(CAOS_DBHEALTHCHECKINTERVAL_OPT_NA
 
 
 
+// CAOS_DBCONNECT_PARALLELISM_OPT_NAME -------------------------------------------------------------
+#ifndef CAOS_DBCONNECT_PARALLELISM_OPT_NAME
+  #define CAOS_DBCONNECT_PARALLELISM_OPT_NAME "dbconnect_parallelism"
+#endif
+
+#define CAOS_DBCONNECT_PARALLELISM_OPT_NAME_ERRMSG "CAOS_DBCONNECT_PARALLELISM_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBCONNECT_PARALLELISM_OPT_NAME), CAOS_DBCONNECT_PARALLELISM_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBPOOLSHARDS_OPT_NAME ----------------------------------------------------------------------
+#ifndef CAOS_DBPOOLSHARDS_OPT_NAME
+  #define CAOS_DBPOOLSHARDS_OPT_NAME "dbpoolshards"
+#endif
+
+#define CAOS_DBPOOLSHARDS_OPT_NAME_ERRMSG "CAOS_DBPOOLSHARDS_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBPOOLSHARDS_OPT_NAME), CAOS_DBPOOLSHARDS_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBTHREADAFFINITY_OPT_NAME ------------------------------------------------------------------
+#ifndef CAOS_DBTHREADAFFINITY_OPT_NAME
+  #define CAOS_DBTHREADAFFINITY_OPT_NAME "dbthreadaffinity"
+#endif
+
+#define CAOS_DBTHREADAFFINITY_OPT_NAME_ERRMSG "CAOS_DBTHREADAFFINITY_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBTHREADAFFINITY_OPT_NAME), CAOS_DBTHREADAFFINITY_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBREPLICAS_OPT_NAME ------------------------------------------------------------------------
+#ifndef CAOS_DBREPLICAS_OPT_NAME
+  #define CAOS_DBREPLICAS_OPT_NAME "dbreplicas"
+#endif
+
+#define CAOS_DBREPLICAS_OPT_NAME_ERRMSG "CAOS_DBREPLICAS_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBREPLICAS_OPT_NAME), CAOS_DBREPLICAS_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERTHRESHOLD_OPT_NAME ----------------------------------------------------------------
+#ifndef CAOS_DBBREAKERTHRESHOLD_OPT_NAME
+  #define CAOS_DBBREAKERTHRESHOLD_OPT_NAME "dbbreakerthreshold"
+#endif
+
+#define CAOS_DBBREAKERTHRESHOLD_OPT_NAME_ERRMSG "CAOS_DBBREAKERTHRESHOLD_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERTHRESHOLD_OPT_NAME), CAOS_DBBREAKERTHRESHOLD_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERBACKOFFMIN_OPT_NAME ---------------------------------------------------------------
+#ifndef CAOS_DBBREAKERBACKOFFMIN_OPT_NAME
+  #define CAOS_DBBREAKERBACKOFFMIN_OPT_NAME "dbbreakerbackoffmin"
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMIN_OPT_NAME_ERRMSG "CAOS_DBBREAKERBACKOFFMIN_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERBACKOFFMIN_OPT_NAME), CAOS_DBBREAKERBACKOFFMIN_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBBREAKERBACKOFFMAX_OPT_NAME ---------------------------------------------------------------
+#ifndef CAOS_DBBREAKERBACKOFFMAX_OPT_NAME
+  #define CAOS_DBBREAKERBACKOFFMAX_OPT_NAME "dbbreakerbackoffmax"
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMAX_OPT_NAME_ERRMSG "CAOS_DBBREAKERBACKOFFMAX_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBBREAKERBACKOFFMAX_OPT_NAME), CAOS_DBBREAKERBACKOFFMAX_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// CAOS_DBINGESTBATCH_OPT_NAME ---------------------------------------------------------------------
+#ifndef CAOS_DBINGESTBATCH_OPT_NAME
+  #define CAOS_DBINGESTBATCH_OPT_NAME "dbingestbatch"
+#endif
+
+#define CAOS_DBINGESTBATCH_OPT_NAME_ERRMSG "CAOS_DBINGESTBATCH_OPT_NAME" APPEND_ERRMSG_NON_EMPTY
+static_assert(is_non_null_and_non_empty_string(CAOS_DBINGESTBATCH_OPT_NAME), CAOS_DBINGESTBATCH_OPT_NAME_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
 // CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_OPT_NAME -------------------------------------------
 #ifndef CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_OPT_NAME
   #define CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_OPT_NAME "log_threshold_connection_limit_exceeded"
@@ -1749,6 +2055,48 @@ static_assert(is_number_non_null_and_at_least<CAOS_DBPOOLTIMEOUT>(CAOS_DBPOOLTIM
   static_assert(is_number_non_null_and_at_least<CAOS_DBKEEPALIVES_COUNT>(CAOS_DBKEEPALIVES_COUNT_LIMIT_MIN), CAOS_DBKEEPALIVES_COUNT_ERRMSG);
   //------------------------------------------------------------------------------------------------
 
+
+
+  // Database async engine connections, 0 leaves the engine off ------------------------------------
+  #define CAOS_DBASYNCCONNECTIONS_DEFAULT    0
+  #define CAOS_DBASYNCCONNECTIONS_LIMIT_MIN  0
+
+  #ifdef CAOS_ENV_ALT                                                                               // CAOS_ENV="test" or CAOS_ENV="debug"
+    #ifdef CAOS_DBASYNCCONNECTIONS_ALT
+      #undef CAOS_DBASYNCCONNECTIONS
+      #define CAOS_DBASYNCCONNECTIONS CAOS_DBASYNCCONNECTIONS_ALT
+    #endif
+  #endif
+
+  #ifndef CAOS_DBASYNCCONNECTIONS
+    #define CAOS_DBASYNCCONNECTIONS CAOS_DBASYNCCONNECTIONS_DEFAULT
+  #endif
+
+  #define CAOS_DBASYNCCONNECTIONS_ERRMSG "CAOS_DBASYNCCONNECTIONS" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBASYNCCONNECTIONS_LIMIT_MIN)
+  static_assert(is_number_non_null_and_at_least<CAOS_DBASYNCCONNECTIONS>(CAOS_DBASYNCCONNECTIONS_LIMIT_MIN), CAOS_DBASYNCCONNECTIONS_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
+
+
+  // Database async engine queries waiting for a connection before new ones are refused ------------
+  #define CAOS_DBASYNCQUEUE_DEFAULT    10000
+  #define CAOS_DBASYNCQUEUE_LIMIT_MIN  1
+
+  #ifdef CAOS_ENV_ALT                                                                               // CAOS_ENV="test" or CAOS_ENV="debug"
+    #ifdef CAOS_DBASYNCQUEUE_ALT
+      #undef CAOS_DBASYNCQUEUE
+      #define CAOS_DBASYNCQUEUE CAOS_DBASYNCQUEUE_ALT
+    #endif
+  #endif
+
+  #ifndef CAOS_DBASYNCQUEUE
+    #define CAOS_DBASYNCQUEUE CAOS_DBASYNCQUEUE_DEFAULT
+  #endif
+
+  #define CAOS_DBASYNCQUEUE_ERRMSG "CAOS_DBASYNCQUEUE" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBASYNCQUEUE_LIMIT_MIN)
+  static_assert(is_number_non_null_and_at_least<CAOS_DBASYNCQUEUE>(CAOS_DBASYNCQUEUE_LIMIT_MIN), CAOS_DBASYNCQUEUE_ERRMSG);
+  //------------------------------------------------------------------------------------------------
+
 #endif // End Of CAOS_USE_DB_POSTGRESQL
 
 
@@ -1816,6 +2164,173 @@ static_assert(is_number_non_null_and_at_least<CAOS_DBHEALTHCHECKINTERVAL>(CAOS_D
 
 
 
+// Database connect parallelism --------------------------------------------------------------------
+#define CAOS_DBCONNECT_PARALLELISM_DEFAULT    4
+#define CAOS_DBCONNECT_PARALLELISM_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBCONNECT_PARALLELISM_ALT
+    #undef CAOS_DBCONNECT_PARALLELISM
+    #define CAOS_DBCONNECT_PARALLELISM CAOS_DBCONNECT_PARALLELISM_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBCONNECT_PARALLELISM
+  #define CAOS_DBCONNECT_PARALLELISM CAOS_DBCONNECT_PARALLELISM_DEFAULT
+#endif
+
+#define CAOS_DBCONNECT_PARALLELISM_ERRMSG "CAOS_DBCONNECT_PARALLELISM" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBCONNECT_PARALLELISM_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBCONNECT_PARALLELISM>(CAOS_DBCONNECT_PARALLELISM_LIMIT_MIN), CAOS_DBCONNECT_PARALLELISM_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database pool shards ----------------------------------------------------------------------------
+#define CAOS_DBPOOLSHARDS_DEFAULT    1
+#define CAOS_DBPOOLSHARDS_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBPOOLSHARDS_ALT
+    #undef CAOS_DBPOOLSHARDS
+    #define CAOS_DBPOOLSHARDS CAOS_DBPOOLSHARDS_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBPOOLSHARDS
+  #define CAOS_DBPOOLSHARDS CAOS_DBPOOLSHARDS_DEFAULT
+#endif
+
+#define CAOS_DBPOOLSHARDS_ERRMSG "CAOS_DBPOOLSHARDS" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBPOOLSHARDS_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBPOOLSHARDS>(CAOS_DBPOOLSHARDS_LIMIT_MIN), CAOS_DBPOOLSHARDS_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database thread affinity ------------------------------------------------------------------------
+#define CAOS_DBTHREADAFFINITY_DEFAULT    0
+#define CAOS_DBTHREADAFFINITY_LIMIT_MIN  0
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBTHREADAFFINITY_ALT
+    #undef CAOS_DBTHREADAFFINITY
+    #define CAOS_DBTHREADAFFINITY CAOS_DBTHREADAFFINITY_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBTHREADAFFINITY
+  #define CAOS_DBTHREADAFFINITY CAOS_DBTHREADAFFINITY_DEFAULT
+#endif
+
+#define CAOS_DBTHREADAFFINITY_ERRMSG "CAOS_DBTHREADAFFINITY" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBTHREADAFFINITY_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBTHREADAFFINITY>(CAOS_DBTHREADAFFINITY_LIMIT_MIN), CAOS_DBTHREADAFFINITY_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database read replicas --------------------------------------------------------------------------
+#define CAOS_DBREPLICAS_DEFAULT ""
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBREPLICAS_ALT
+    #undef CAOS_DBREPLICAS
+    #define CAOS_DBREPLICAS CAOS_DBREPLICAS_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBREPLICAS
+  #define CAOS_DBREPLICAS CAOS_DBREPLICAS_DEFAULT
+#endif
+
+#define CAOS_DBREPLICAS_ERRMSG "CAOS_DBREPLICAS" APPEND_ERRMSG_NON_NULL
+static_assert(is_non_null_string(CAOS_DBREPLICAS), CAOS_DBREPLICAS_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database circuit breaker threshold --------------------------------------------------------------
+#define CAOS_DBBREAKERTHRESHOLD_DEFAULT    5
+#define CAOS_DBBREAKERTHRESHOLD_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBBREAKERTHRESHOLD_ALT
+    #undef CAOS_DBBREAKERTHRESHOLD
+    #define CAOS_DBBREAKERTHRESHOLD CAOS_DBBREAKERTHRESHOLD_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBBREAKERTHRESHOLD
+  #define CAOS_DBBREAKERTHRESHOLD CAOS_DBBREAKERTHRESHOLD_DEFAULT
+#endif
+
+#define CAOS_DBBREAKERTHRESHOLD_ERRMSG "CAOS_DBBREAKERTHRESHOLD" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBBREAKERTHRESHOLD_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBBREAKERTHRESHOLD>(CAOS_DBBREAKERTHRESHOLD_LIMIT_MIN), CAOS_DBBREAKERTHRESHOLD_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database circuit breaker backoff min ------------------------------------------------------------
+#define CAOS_DBBREAKERBACKOFFMIN_DEFAULT    250
+#define CAOS_DBBREAKERBACKOFFMIN_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBBREAKERBACKOFFMIN_ALT
+    #undef CAOS_DBBREAKERBACKOFFMIN
+    #define CAOS_DBBREAKERBACKOFFMIN CAOS_DBBREAKERBACKOFFMIN_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBBREAKERBACKOFFMIN
+  #define CAOS_DBBREAKERBACKOFFMIN CAOS_DBBREAKERBACKOFFMIN_DEFAULT
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMIN_ERRMSG "CAOS_DBBREAKERBACKOFFMIN" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBBREAKERBACKOFFMIN_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBBREAKERBACKOFFMIN>(CAOS_DBBREAKERBACKOFFMIN_LIMIT_MIN), CAOS_DBBREAKERBACKOFFMIN_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database circuit breaker backoff max ------------------------------------------------------------
+#define CAOS_DBBREAKERBACKOFFMAX_DEFAULT    30000
+#define CAOS_DBBREAKERBACKOFFMAX_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBBREAKERBACKOFFMAX_ALT
+    #undef CAOS_DBBREAKERBACKOFFMAX
+    #define CAOS_DBBREAKERBACKOFFMAX CAOS_DBBREAKERBACKOFFMAX_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBBREAKERBACKOFFMAX
+  #define CAOS_DBBREAKERBACKOFFMAX CAOS_DBBREAKERBACKOFFMAX_DEFAULT
+#endif
+
+#define CAOS_DBBREAKERBACKOFFMAX_ERRMSG "CAOS_DBBREAKERBACKOFFMAX" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBBREAKERBACKOFFMAX_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBBREAKERBACKOFFMAX>(CAOS_DBBREAKERBACKOFFMAX_LIMIT_MIN), CAOS_DBBREAKERBACKOFFMAX_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
+// Database rows per statement of a bulk ingest ----------------------------------------------------
+#define CAOS_DBINGESTBATCH_DEFAULT    1000
+#define CAOS_DBINGESTBATCH_LIMIT_MIN  1
+
+#ifdef CAOS_ENV_ALT                                                                                 // CAOS_ENV="test" or CAOS_ENV="debug"
+  #ifdef CAOS_DBINGESTBATCH_ALT
+    #undef CAOS_DBINGESTBATCH
+    #define CAOS_DBINGESTBATCH CAOS_DBINGESTBATCH_ALT
+  #endif
+#endif
+
+#ifndef CAOS_DBINGESTBATCH
+  #define CAOS_DBINGESTBATCH CAOS_DBINGESTBATCH_DEFAULT
+#endif
+
+#define CAOS_DBINGESTBATCH_ERRMSG "CAOS_DBINGESTBATCH" APPEND_ERRMSG_AT_LEAST TOSTRING(CAOS_DBINGESTBATCH_LIMIT_MIN)
+static_assert(is_number_non_null_and_at_least<CAOS_DBINGESTBATCH>(CAOS_DBINGESTBATCH_LIMIT_MIN), CAOS_DBINGESTBATCH_ERRMSG);
+//--------------------------------------------------------------------------------------------------
+
+
+
 // Database log threshold connection limit exceeded ++++++++++++++++++++++++++++++++++++++++++++++++
 #define CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_DEFAULT    50
 #define CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_LIMIT_MIN  0
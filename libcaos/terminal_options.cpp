@@ -38,6 +38,8 @@ TerminalOptions::TerminalOptions(int argc, char** argv) : argc(argc), argv(argv)
     (CAOS_CACHEPOOLCONNECTIONTIMEOUT_OPT_NAME         , "Cache Pool Connection Timeout"   , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_CACHEPOOLCONNECTIONTIMEOUT))       )
     (CAOS_CACHEPOOLCONNECTIONLIFETIME_OPT_NAME        , "Cache Pool Connection Lifetime"  , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_CACHEPOOLCONNECTIONLIFETIME))      )
     (CAOS_CACHEPOOLCONNECTIONIDLETIME_OPT_NAME        , "Cache Pool Connection Idle-time" , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_CACHEPOOLCONNECTIONIDLETIME))      )
+    (CAOS_CACHEEXECUTORTHREADS_OPT_NAME               , "Cache Executor Threads"          , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_CACHEEXECUTORTHREADS))               )
+    (CAOS_CACHEEXECUTORQUEUE_OPT_NAME                 , "Cache Executor Queue"            , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_CACHEEXECUTORQUEUE))                 )
 #endif
 
     // Database
@@ -55,10 +57,20 @@ TerminalOptions::TerminalOptions(int argc, char** argv) : argc(argc), argv(argv)
     (CAOS_DBKEEPALIVES_IDLE_OPT_NAME                  , "Database Keepalives Idle"        , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBKEEPALIVES_IDLE))                  )
     (CAOS_DBKEEPALIVES_INTERVAL_OPT_NAME              , "Database Keepalives Interval"    , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBKEEPALIVES_INTERVAL))              )
     (CAOS_DBKEEPALIVES_COUNT_OPT_NAME                 , "Database Keepalives Count"       , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBKEEPALIVES_COUNT))                 )
+    (CAOS_DBASYNCCONNECTIONS_OPT_NAME                 , "Database Async Connections"      , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBASYNCCONNECTIONS))                 )
+    (CAOS_DBASYNCQUEUE_OPT_NAME                       , "Database Async Queue"            , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBASYNCQUEUE))                       )
 #endif
     (CAOS_DBCONNECT_TIMEOUT_OPT_NAME                  , "Database Connect Timeout"        , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBCONNECT_TIMEOUT))                  )
     (CAOS_DBMAXWAIT_OPT_NAME                          , "Database Max Wait"               , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_DBMAXWAIT))                        )
     (CAOS_DBHEALTHCHECKINTERVAL_OPT_NAME              , "Database Health Check interval"  , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_DBHEALTHCHECKINTERVAL))            )
+    (CAOS_DBCONNECT_PARALLELISM_OPT_NAME              , "Database Connect Parallelism"    , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBCONNECT_PARALLELISM))              )
+    (CAOS_DBPOOLSHARDS_OPT_NAME                       , "Database Pool Shards"            , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBPOOLSHARDS))                       )
+    (CAOS_DBTHREADAFFINITY_OPT_NAME                   , "Database Thread Affinity"        , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_DBTHREADAFFINITY))                 )
+    (CAOS_DBREPLICAS_OPT_NAME                         , "Database Read Replicas"          , cxxopts::value<std::string>()->default_value(CAOS_DBREPLICAS)                                         )
+    (CAOS_DBBREAKERTHRESHOLD_OPT_NAME                 , "Database Breaker Threshold"      , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBBREAKERTHRESHOLD))                 )
+    (CAOS_DBBREAKERBACKOFFMIN_OPT_NAME                , "Database Breaker Backoff Min"    , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_DBBREAKERBACKOFFMIN))              )
+    (CAOS_DBBREAKERBACKOFFMAX_OPT_NAME                , "Database Breaker Backoff Max"    , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_DBBREAKERBACKOFFMAX))              )
+    (CAOS_DBINGESTBATCH_OPT_NAME                      , "Database Ingest Batch"           , cxxopts::value<std::size_t>()->default_value(std::to_string(CAOS_DBINGESTBATCH))                      )
 
     (CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED_OPT_NAME , "Database Health Check interval"  , cxxopts::value<std::uint32_t>()->default_value(std::to_string(CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED))  )
     // (CAOS_VALIDATE_CONNECTION_BEFORE_ACQUIRE_OPT_NAME      , "Database Healtch Check interval" , cxxopts::value<bool>()->default_value(std::to_string(CAOS_VALIDATE_CONNECTION_BEFORE_ACQUIRE))                     )
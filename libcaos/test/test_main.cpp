@@ -13,6 +13,11 @@
 #include "libcaos.hpp"
 #include "tests/terminal_options.hpp"
 #include "tests/log.hpp"
+#include "tests/telemetry.hpp"
+#include "tests/coalescer.hpp"
+#include "tests/single_flight.hpp"
+#include "tests/executor.hpp"
+#include "tests/async_engine.hpp"
 
 
 // class GlobalTestSetup
@@ -0,0 +1,86 @@
+#pragma once
+
+#ifdef CAOS_USE_DB_POSTGRESQL
+
+#include <atomic>
+#include <chrono>
+#include "PostgreSQL/AsyncEngine.hpp"
+
+// Nothing listens on port 1: the engine keeps retrying and the queries wait for a connection
+static constexpr const char* unreachable = "host=127.0.0.1 port=1 dbname=caos user=caos connect_timeout=1";
+
+TEST_CASE("Queued queries fail after maxWait while no connection is up [async_engine]")
+{
+  using namespace std::chrono_literals;
+
+  AsyncEngine engine(unreachable, 2, 1024, 1s, 200ms, 20ms, 100ms);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::future<AsyncEngine::Result> result = engine.query("SELECT $1::text", {"caos"});
+
+  REQUIRE_THROWS_AS(result.get(), repository::broken_connection);
+  REQUIRE(std::chrono::steady_clock::now() - start >= 200ms);
+  REQUIRE(engine.connected() == 0);
+  REQUIRE(engine.pending() == 0);
+}
+
+TEST_CASE("Destroying the engine fails what is still queued [async_engine]")
+{
+  using namespace std::chrono_literals;
+
+  std::atomic<int> failed{0};
+
+  {
+    AsyncEngine engine(unreachable, 1, 1024, 1s, 60s, 20ms, 100ms);
+
+    for (int i = 0; i < 100; ++i)
+    {
+      engine.query("SELECT 1", {}, [&failed](std::future<AsyncEngine::Result> result)
+      {
+        try
+        {
+          (void)result.get();
+        }
+        catch (const repository::broken_connection&)
+        {
+          ++failed;
+        }
+      });
+    }
+  }
+
+  REQUIRE(failed == 100);
+}
+
+TEST_CASE("A full queue refuses new queries instead of growing [async_engine]")
+{
+  using namespace std::chrono_literals;
+
+  std::atomic<int> refused{0};
+
+  AsyncEngine engine(unreachable, 1, 2, 1s, 60s, 20ms, 100ms);
+
+  std::future<AsyncEngine::Result> first  = engine.query("SELECT 1");
+  std::future<AsyncEngine::Result> second = engine.query("SELECT 2");
+  std::future<AsyncEngine::Result> extra  = engine.query("SELECT 3");
+
+  engine.query("SELECT 4", {}, [&refused](std::future<AsyncEngine::Result> result)
+  {
+    try
+    {
+      (void)result.get();
+    }
+    catch (const repository::broken_connection&)
+    {
+      ++refused;
+    }
+  });
+
+  REQUIRE(extra.wait_for(0s) == std::future_status::ready);                                        // Refused at once, not after maxWait
+  REQUIRE_THROWS_AS(extra.get(), repository::broken_connection);
+  REQUIRE(refused == 1);
+  REQUIRE(engine.pending() == 2);
+}
+
+#endif
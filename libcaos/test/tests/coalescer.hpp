@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "Coalescer.hpp"
+
+TEST_CASE("Concurrent lookups share one batch and each get their own value [coalescer]")
+{
+  constexpr std::size_t threads = 8;
+
+  Coalescer<int, int> coalescer(std::chrono::seconds(5), threads);
+
+  std::atomic<std::size_t> batches{0};
+  std::atomic<std::size_t> keys{0};
+  std::vector<std::optional<int>> values(threads);
+  std::vector<std::thread> workers;
+
+  const auto batch = [&batches, &keys](const std::vector<int>& group)
+  {
+    ++batches;
+    keys += group.size();
+
+    std::vector<std::optional<int>> result;
+
+    for (int key : group)
+    {
+      result.push_back(key % 2 ? std::optional<int>(key * 10) : std::nullopt);
+    }
+
+    return result;
+  };
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&, t]()
+    {
+      values[t] = coalescer.load(static_cast<int>(t), batch);
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  // The keys cap closes the group long before the window ends
+  REQUIRE(batches == 1);
+  REQUIRE(keys == threads);
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    REQUIRE(values[t] == (t % 2 ? std::optional<int>(static_cast<int>(t) * 10) : std::nullopt));
+  }
+}
+
+TEST_CASE("A lone lookup runs its batch when the window ends [coalescer]")
+{
+  Coalescer<std::string, std::string> coalescer(std::chrono::microseconds(200), 64);
+
+  const auto value = coalescer.load("key", [](const std::vector<std::string>& group)
+  {
+    REQUIRE(group == std::vector<std::string>{"key"});
+
+    return std::vector<std::optional<std::string>>{"value"};
+  });
+
+  REQUIRE(value == "value");
+}
+
+TEST_CASE("Same key asked concurrently is looked up once [coalescer]")
+{
+  constexpr std::size_t threads = 4;
+
+  Coalescer<int, int> coalescer(std::chrono::milliseconds(200), 64);
+
+  std::atomic<std::size_t> ready{0};
+  std::atomic<std::size_t> joined{0};
+  std::atomic<std::size_t> batches{0};
+  std::atomic<std::size_t> keys{0};
+  std::atomic<std::size_t> answered{0};
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&]()
+    {
+      // Start every caller together, well inside the window of the group the first one opens
+      ++ready;
+
+      while (ready < threads)
+      {
+        std::this_thread::yield();
+      }
+
+      ++joined;
+
+      const auto value = coalescer.load(42, [&](const std::vector<int>& group)
+      {
+        ++batches;
+        keys += group.size();
+
+        // Hold the group until every caller has joined it
+        while (joined < threads)
+        {
+          std::this_thread::yield();
+        }
+
+        return std::vector<std::optional<int>>(group.size(), 7);
+      });
+
+      if (value == 7)
+      {
+        ++answered;
+      }
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  REQUIRE(answered == threads);
+  REQUIRE(batches == 1);
+  REQUIRE(keys == 1);
+}
+
+TEST_CASE("A failing batch throws to every caller of its group [coalescer]")
+{
+  constexpr std::size_t threads = 4;
+
+  Coalescer<int, int> coalescer(std::chrono::seconds(5), threads);
+
+  std::atomic<std::size_t> failed{0};
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&, t]()
+    {
+      try
+      {
+        (void)coalescer.load(static_cast<int>(t), [](const std::vector<int>&) -> std::vector<std::optional<int>>
+        {
+          throw std::runtime_error("connection lost");
+        });
+      }
+      catch (const std::runtime_error&)
+      {
+        ++failed;
+      }
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  REQUIRE(failed == threads);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "Executor.hpp"
+
+TEST_CASE("Submitted tasks deliver their value or their exception [executor]")
+{
+  Executor executor(2, 16);
+
+  std::future<int>  value  = executor.submit([]() { return 42; });
+  std::future<void> failed = executor.submit([]() { throw std::runtime_error("connection lost"); });
+
+  REQUIRE(value.get() == 42);
+  REQUIRE_THROWS_AS(failed.get(), std::runtime_error);
+}
+
+TEST_CASE("Callbacks get the ready future on an executor thread [executor]")
+{
+  std::atomic<int>             sum{0};
+  std::atomic<bool>            offThread{true};
+  const std::thread::id        caller = std::this_thread::get_id();
+
+  {
+    Executor executor(4, 64);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+      executor.submit([i]() { return i; }, [&](std::future<int> result)
+      {
+        sum += result.get();
+
+        if (std::this_thread::get_id() == caller)
+        {
+          offThread = false;
+        }
+      });
+    }
+  }                                                                                                 // Drains the queue
+
+  REQUIRE(sum == 55);
+  REQUIRE(offThread);
+}
+
+TEST_CASE("A full queue refuses new tasks instead of growing [executor]")
+{
+  std::atomic<bool> release{false};
+  std::atomic<int>  refused{0};
+
+  {
+    Executor executor(1, 1);
+
+    std::future<void> busy = executor.submit([&release]()
+    {
+      while (!release)
+      {
+        std::this_thread::yield();
+      }
+    });
+
+    while (executor.pending() != 0)                                                                 // Wait for the worker to pick it up
+    {
+      std::this_thread::yield();
+    }
+
+    std::future<int> queued = executor.submit([]() { return 1; });
+    std::future<int> extra  = executor.submit([]() { return 2; });
+
+    executor.submit([]() { return 3; }, [&refused](std::future<int> result)
+    {
+      try
+      {
+        (void)result.get();
+      }
+      catch (const repository::broken_connection&)
+      {
+        ++refused;
+      }
+    });
+
+    REQUIRE_THROWS_AS(extra.get(), repository::broken_connection);
+    REQUIRE(refused == 1);
+
+    release = true;
+
+    REQUIRE(queued.get() == 1);
+  }
+}
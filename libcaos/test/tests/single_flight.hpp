@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "SingleFlight.hpp"
+
+TEST_CASE("Keys tell arguments apart [single_flight]")
+{
+  REQUIRE(SingleFlight<int>::key(std::string("ab"), std::string("c")) != SingleFlight<int>::key(std::string("a"), std::string("bc")));
+  REQUIRE(SingleFlight<int>::key(1, 23) != SingleFlight<int>::key(12, 3));
+  REQUIRE(SingleFlight<int>::key(std::vector<std::string>{"a", "b"}) != SingleFlight<int>::key(std::vector<std::string>{"ab"}));
+  REQUIRE(SingleFlight<int>::key(std::string("x"), 7) == SingleFlight<int>::key("x", 7));
+  REQUIRE(SingleFlight<int>::key(1e-7) != SingleFlight<int>::key(0.0));
+  REQUIRE(SingleFlight<int>::key(0.1234561) != SingleFlight<int>::key(0.1234564));
+}
+
+TEST_CASE("Identical calls in flight run once [single_flight]")
+{
+  constexpr std::size_t threads = 8;
+
+  SingleFlight<std::optional<std::string>> flight;
+
+  std::atomic<std::size_t> calls{0};
+  std::atomic<std::size_t> started{0};
+  std::atomic<std::size_t> answered{0};
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&]()
+    {
+      ++started;
+
+      const auto value = flight.run(SingleFlight<std::optional<std::string>>::key("key"), [&]()
+      {
+        ++calls;
+
+        // Keep the first call in flight until every caller has arrived, then long enough for the
+        // last ones to find it
+        while (started < threads)
+        {
+          std::this_thread::yield();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        return std::optional<std::string>("value");
+      });
+
+      if (value == "value")
+      {
+        ++answered;
+      }
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  REQUIRE(answered == threads);
+  REQUIRE(calls == 1);
+}
+
+TEST_CASE("Calls run again once the previous one landed [single_flight]")
+{
+  SingleFlight<int> flight;
+
+  std::size_t calls = 0;
+
+  REQUIRE(flight.run("key", [&calls]() { return static_cast<int>(++calls); }) == 1);
+  REQUIRE(flight.run("key", [&calls]() { return static_cast<int>(++calls); }) == 2);
+}
+
+TEST_CASE("A failing call throws to every caller waiting for it [single_flight]")
+{
+  constexpr std::size_t threads = 8;
+
+  SingleFlight<int> flight;
+
+  std::atomic<std::size_t> calls{0};
+  std::atomic<std::size_t> started{0};
+  std::atomic<std::size_t> failed{0};
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&]()
+    {
+      ++started;
+
+      try
+      {
+        (void)flight.run("key", [&]() -> int
+        {
+          ++calls;
+
+          while (started < threads)
+          {
+            std::this_thread::yield();
+          }
+
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+          throw std::runtime_error("connection lost");
+        });
+      }
+      catch (const std::runtime_error&)
+      {
+        ++failed;
+      }
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  REQUIRE(calls == 1);
+  REQUIRE(failed == threads);
+
+  // The failure isn't kept either: the next call runs
+  REQUIRE(flight.run("key", []() { return 1; }) == 1);
+}
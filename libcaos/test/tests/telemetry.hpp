@@ -0,0 +1,131 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+#include "Telemetry.hpp"
+
+TEST_CASE("Histogram buckets keep values within their precision [telemetry]")
+{
+  SECTION("Small values are exact")
+  {
+    for (std::uint64_t value = 0; value < Telemetry::Histogram::subBucketCount; ++value)
+    {
+      REQUIRE(Telemetry::Histogram::bucketUpperBound(Telemetry::Histogram::bucketIndex(value)) == value);
+    }
+  }
+
+  SECTION("Every value is at most its bucket upper bound, within 1/32")
+  {
+    for (std::uint64_t value : {32ull, 33ull, 63ull, 64ull, 65ull, 1000ull, 123456ull, 987654321ull})
+    {
+      const std::uint64_t upper = Telemetry::Histogram::bucketUpperBound(Telemetry::Histogram::bucketIndex(value));
+
+      REQUIRE(upper >= value);
+      REQUIRE(upper - value <= value / Telemetry::Histogram::subBucketCount);
+    }
+  }
+
+  SECTION("Bucket indexes grow with the value and never overflow")
+  {
+    std::size_t previous = 0;
+
+    for (std::uint64_t value = 1; value < (std::uint64_t{1} << 50); value = value * 3 / 2 + 1)
+    {
+      const std::size_t index = Telemetry::Histogram::bucketIndex(value);
+
+      REQUIRE(index >= previous);
+      REQUIRE(index < Telemetry::Histogram::bucketCount);
+
+      previous = index;
+    }
+
+    REQUIRE(Telemetry::Histogram::bucketIndex(std::numeric_limits<std::uint64_t>::max()) == Telemetry::Histogram::bucketCount - 1);
+  }
+}
+
+TEST_CASE("Histogram snapshot reports count, extremes and percentiles [telemetry]")
+{
+  auto histogram = std::make_unique<Telemetry::Histogram>();
+
+  SECTION("Empty histogram")
+  {
+    const Telemetry::Snapshot snap = histogram->snapshot();
+
+    REQUIRE(snap.count == 0);
+    REQUIRE(snap.min == 0);
+    REQUIRE(snap.max == 0);
+    REQUIRE(snap.mean() == 0.0);
+    REQUIRE(snap.percentile(99.0) == 0);
+  }
+
+  SECTION("Values 1 to 1000")
+  {
+    for (std::uint64_t value = 1; value <= 1000; ++value)
+    {
+      histogram->record(value);
+    }
+
+    const Telemetry::Snapshot snap = histogram->snapshot();
+
+    REQUIRE(snap.count == 1000);
+    REQUIRE(snap.sum == 500500);
+    REQUIRE(snap.min == 1);
+    REQUIRE(snap.max == 1000);
+    REQUIRE(snap.mean() == 500.5);
+
+    REQUIRE(snap.percentile(0.0) == 1);
+    REQUIRE(snap.percentile(100.0) == 1000);
+    REQUIRE(snap.percentile(50.0) >= 500);
+    REQUIRE(snap.percentile(50.0) <= 500 + 500 / 32);
+    REQUIRE(snap.percentile(99.0) >= 990);
+    REQUIRE(snap.percentile(99.0) <= 1000);
+  }
+
+  SECTION("Durations are recorded in microseconds")
+  {
+    histogram->record(std::chrono::milliseconds(3));
+    histogram->record(std::chrono::steady_clock::duration(-1));
+
+    const Telemetry::Snapshot snap = histogram->snapshot();
+
+    REQUIRE(snap.count == 2);
+    REQUIRE(snap.min == 0);
+    REQUIRE(snap.max == 3000);
+  }
+}
+
+TEST_CASE("Concurrent recording loses nothing [telemetry]")
+{
+  constexpr std::size_t threads    = 8;
+  constexpr std::size_t iterations = 10000;
+
+  auto               histogram = std::make_unique<Telemetry::Histogram>();
+  Telemetry::Counter counter;
+
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&histogram, &counter, t]()
+    {
+      for (std::size_t i = 0; i < iterations; ++i)
+      {
+        histogram->record(t + 1);
+        counter.increment();
+      }
+    });
+  }
+
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  const Telemetry::Snapshot snap = histogram->snapshot();
+
+  REQUIRE(snap.count == threads * iterations);
+  REQUIRE(snap.sum == iterations * threads * (threads + 1) / 2);
+  REQUIRE(snap.min == 1);
+  REQUIRE(snap.max == threads);
+  REQUIRE(counter.value() == threads * iterations);
+}
@@ -31,23 +31,13 @@ std::optional<std::string> Redis::IQuery_Template_echoString(std::string str)
     // 3. Cache miss - query database
     db_result = this->database->IQuery_Template_echoString(str);
 
-    // 4. Database return a value, store in cache
+    // 4. Database return a value, store in cache without waiting for Redis
     if (db_result.has_value())
     {
-      try
-      {
-        // Store in Redis con TTL (es. 5 minutes)
-        this->redis->setex(cache_key,
-                    std::chrono::seconds(300),
-                    db_result.value());
-
-        spdlog::debug("[{}] Stored in cache with key: {}", fName, cache_key);
-      }
-      catch (const sw::redis::Error& e)
-      {
-        // Log dell'errore ma non fallire - la query può comunque restituire il risultato
-        spdlog::warn("[{}] Failed to store in cache: {}", fName, e.what());
-      }
+      // Store in Redis con TTL (es. 5 minutes), errors are logged by fill()
+      this->fill(cache_key, std::chrono::seconds(300), db_result.value());
+
+      spdlog::debug("[{}] Storing in cache with key: {}", fName, cache_key);
     }
 
     return db_result;
@@ -106,23 +96,13 @@ std::optional<std::string> Redis::IQuery_Template_echoString_custom(std::string
     // 3. Cache miss - query database
     db_result = this->database->IQuery_Template_echoString_custom(str);
 
-    // 4. Database return a value, store in cache
+    // 4. Database return a value, store in cache without waiting for Redis
     if (db_result.has_value())
     {
-      try
-      {
-        // Store in Redis con TTL (es. 5 minutes)
-        this->redis->setex(cache_key,
-                    std::chrono::seconds(300),
-                    db_result.value());
-
-        spdlog::debug("[{}] Stored in cache with key: {}", fName, cache_key);
-      }
-      catch (const sw::redis::Error& e)
-      {
-        // Log dell'errore ma non fallire - la query può comunque restituire il risultato
-        spdlog::warn("[{}] Failed to store in cache: {}", fName, e.what());
-      }
+      // Store in Redis con TTL (es. 5 minutes), errors are logged by fill()
+      this->fill(cache_key, std::chrono::seconds(300), db_result.value());
+
+      spdlog::debug("[{}] Storing in cache with key: {}", fName, cache_key);
     }
 
     return db_result;
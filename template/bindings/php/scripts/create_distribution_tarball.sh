@@ -351,6 +351,8 @@ This document describes all environment variables used by the ${PROJECT_NAME} PH
 | \`CAOS_CACHEPOOLCONNECTIONTIMEOUT\` | Timeout for establishing connection (seconds) | \`10\` | \`30\` |
 | \`CAOS_CACHEPOOLCONNECTIONLIFETIME\` | Absolute maximum lifetime of a connection (seconds) | \`3600\` | \`7200\` |
 | \`CAOS_CACHEPOOLCONNECTIONIDLETIME\` | Maximum inactivity duration before closing connection (seconds) | \`300\` | \`600\` |
+| \`CAOS_CACHEEXECUTORTHREADS\` | Threads running the _async query variants | \`8\` | \`16\` |
+| \`CAOS_CACHEEXECUTORQUEUE\` | _async calls, and apart cache fills, waiting before new ones are refused | \`1024\` | \`4096\` |
 
 ## Database Configuration
 
@@ -368,6 +370,16 @@ This document describes all environment variables used by the ${PROJECT_NAME} PH
 | \`CAOS_DBCONNECT_TIMEOUT\` | Database connection timeout (seconds) | \`10\` | \`30\` |
 | \`CAOS_DBMAXWAIT\` | Maximum wait time for database operations (seconds) | \`30\` | \`60\` |
 | \`CAOS_DBHEALTHCHECKINTERVAL\` | Health check interval for database connections (seconds) | \`30\` | \`60\` |
+| \`CAOS_DBCONNECT_PARALLELISM\` | Maximum number of database connections opened concurrently | \`4\` | \`8\` |
+| \`CAOS_DBPOOLSHARDS\` | Number of independently locked sub-pools the connections are spread over | \`1\` | \`8\` |
+| \`CAOS_DBTHREADAFFINITY\` | Time a worker thread may keep its last connection while idle, 0 disables thread affinity (milliseconds) | \`0\` | \`50\` |
+| \`CAOS_DBREPLICAS\` | Comma-separated read replicas as host or host:port (port defaults to CAOS_DBPORT); queries with access: read are served there | - | \`10.0.0.2,10.0.0.3:5433\` |
+| \`CAOS_DBBREAKERTHRESHOLD\` | Failed connection attempts, checks or connections broken while in use, in a row, that open the circuit breaker; requests then fail at once until a probe reconnects | \`5\` | \`3\` |
+| \`CAOS_DBBREAKERBACKOFFMIN\` | First wait before probing the database once the circuit is open, doubled on every failed probe with random jitter (milliseconds) | \`250\` | \`100\` |
+| \`CAOS_DBBREAKERBACKOFFMAX\` | Longest wait between probes while the circuit is open (milliseconds) | \`30000\` | \`10000\` |
+| \`CAOS_DBINGESTBATCH\` | Rows per batch of an ingest query on MySQL/MariaDB, a multi-row INSERT or an array-bound batch (PostgreSQL sends them all with COPY) | \`1000\` | \`5000\` |
+| \`CAOS_DBASYNCCONNECTIONS\` | PostgreSQL only: non-blocking connections one thread multiplexes queries over for database->asyncEngine(), 0 disables the engine | \`0\` | \`4\` |
+| \`CAOS_DBASYNCQUEUE\` | PostgreSQL only: queries waiting for an async engine connection before new ones are refused | \`10000\` | \`50000\` |
 | \`CAOS_LOG_THRESHOLD_CONNECTION_LIMIT_EXCEEDED\` | Log threshold for connection limit exceeded events | - | \`WARNING\` |
 | \`CAOS_VALIDATE_CONNECTION_BEFORE_ACQUIRE\` | Validate connection before acquiring from pool (\`true\`/\`false\`) | \`true\` | \`false\` |
 | \`CAOS_VALIDATE_USING_TRANSACTION\` | Validate connection using transaction (\`true\`/\`false\`) | \`false\` | \`true\` |
@@ -20,38 +20,20 @@ std::optional<std::string> MySQL::IQuery_Template_echoString(std::string str)
     {
       Database::ConnectionWrapper& connection = connection_opt.value();
 
-      // Disable autocommit mocking a transaction
-      connection->setAutoCommit(false);
+      // A single SELECT runs in autocommit: no BEGIN/COMMIT nor SET autocommit round trips
+      sql::PreparedStatement& pstmt = connection.prepared("IQuery_Template_echoString", "SELECT ? as echoed_string");
 
-      try
-      {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-          connection->prepareStatement("SELECT ? as echoed_string")
-        );
-
-        pstmt->setString(1, str);
-        std::unique_ptr<sql::ResultSet> result(pstmt->executeQuery());
-
-        std::optional<std::string> returnValue = std::nullopt;
+      pstmt.setString(1, str);
+      std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());
 
-        if (result->next())
-        {
-          returnValue = result->getString("echoed_string") + " from MySQL";
-        }
+      std::optional<std::string> returnValue = std::nullopt;
 
-        // Explicit commit
-        connection->commit();
-        connection->setAutoCommit(true);
-
-        return returnValue;
-      }
-      catch (...)
+      if (result->next())
       {
-        // Rollback
-        try { connection->rollback(); } catch (...) {}
-        try { connection->setAutoCommit(true); } catch (...) {}
-        throw;
+        returnValue = result->getString("echoed_string") + " from MySQL";
       }
+
+      return returnValue;
     }
 
     throw repository::broken_connection("Database connection unavailable - cannot acquire connection from pool");
@@ -110,38 +92,20 @@ std::optional<std::string> MySQL::IQuery_Template_echoString_custom(std::string
     {
       Database::ConnectionWrapper& connection = connection_opt.value();
 
-      // Disable autocommit mocking a transaction
-      connection->setAutoCommit(false);
+      // A single SELECT runs in autocommit: no BEGIN/COMMIT nor SET autocommit round trips
+      sql::PreparedStatement& pstmt = connection.prepared("IQuery_Template_echoString_custom", "SELECT ? as echoed_string");
 
-      try
-      {
-        std::unique_ptr<sql::PreparedStatement> pstmt(
-          connection->prepareStatement("SELECT ? as echoed_string")
-        );
-
-        pstmt->setString(1, str);
-        std::unique_ptr<sql::ResultSet> result(pstmt->executeQuery());
-
-        std::optional<std::string> returnValue = std::nullopt;
+      pstmt.setString(1, str);
+      std::unique_ptr<sql::ResultSet> result(pstmt.executeQuery());
 
-        if (result->next())
-        {
-          returnValue = result->getString("echoed_string") + " from MySQL";
-        }
+      std::optional<std::string> returnValue = std::nullopt;
 
-        // Explicit commit
-        connection->commit();
-        connection->setAutoCommit(true);
-
-        return returnValue;
-      }
-      catch (...)
+      if (result->next())
       {
-        // Rollback
-        try { connection->rollback(); } catch (...) {}
-        try { connection->setAutoCommit(true); } catch (...) {}
-        throw;
+        returnValue = result->getString("echoed_string") + " from MySQL";
       }
+
+      return returnValue;
     }
 
     throw repository::broken_connection("Database connection unavailable - cannot acquire connection from pool");
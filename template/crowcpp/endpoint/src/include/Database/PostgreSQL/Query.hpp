@@ -23,11 +23,12 @@ std::optional<std::string> PostgreSQL::IQuery_Template_echoString(std::string st
       pqxx::result result;
 
       {
-        pqxx::work tx(*connection);
+        const pqxx::prepped statement = connection.prepared("IQuery_Template_echoString", "SELECT  $1");
+
+        pqxx::nontransaction tx(*connection);                                    // Single SELECT: no BEGIN/COMMIT
         pqxx::params p;
         p.append(str);
-        result = tx.exec("SELECT  $1", p);/*pg_sleep(0.05),*/
-        tx.commit();
+        result = tx.exec(statement, p);/*pg_sleep(0.05),*/
       }
 
       if (!result.empty())
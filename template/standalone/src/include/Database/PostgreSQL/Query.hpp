@@ -23,11 +23,12 @@ std::optional<std::string> PostgreSQL::IQuery_your_query(std::string str)
       pqxx::result result;
 
       {
-        pqxx::work tx(*connection);
+        const pqxx::prepped statement = connection.prepared("IQuery_your_query", "SELECT  $1");
+
+        pqxx::nontransaction tx(*connection);                                    // Single SELECT: no BEGIN/COMMIT
         pqxx::params p;
         p.append(str);
-        result = tx.exec("SELECT  $1", p);
-        tx.commit();
+        result = tx.exec(statement, p);
       }
 
       if (!result.empty())